@@ -0,0 +1,138 @@
+#include <bitset>
+#include <cstdio>
+#include <ctime>
+#include <memory>
+#include <vector>
+#include "../bit_vector.hpp"
+
+
+#if defined(USE_LNI_VECTOR)
+
+typedef lni::bit_vector bitmap;
+
+#else
+
+typedef std::vector<bool> bitmap;
+
+#endif
+
+
+const int N = 1 << 24;
+const int R = 50;
+
+// pseudo-random but deterministic bit pattern
+inline bool bit_at(unsigned seed, int i) {
+	return ((i * 2654435761u) ^ seed) % 7 == 0;
+}
+
+#if defined(USE_LNI_VECTOR)
+
+inline size_t count(const bitmap &b) { return b.count(); }
+
+inline size_t scan(const bitmap &b) {
+	size_t s = 0;
+	for (auto pos = b.find_first(); pos != bitmap::npos; pos = b.find_next(pos))
+		s += pos;
+	return s;
+}
+
+inline void and_with(bitmap &a, const bitmap &b) { a &= b; }
+inline void or_with(bitmap &a, const bitmap &b) { a |= b; }
+inline void xor_with(bitmap &a, const bitmap &b) { a ^= b; }
+
+#else
+
+inline size_t count(const bitmap &b) {
+	size_t cnt = 0;
+	for (bool x: b)
+		cnt += x;
+	return cnt;
+}
+
+inline size_t scan(const bitmap &b) {
+	size_t s = 0;
+	for (size_t i = 0; i < b.size(); ++i)
+		if (b[i])
+			s += i;
+	return s;
+}
+
+inline void and_with(bitmap &a, const bitmap &b) {
+	for (size_t i = 0; i < a.size(); ++i)
+		a[i] = a[i] && b[i];
+}
+inline void or_with(bitmap &a, const bitmap &b) {
+	for (size_t i = 0; i < a.size(); ++i)
+		a[i] = a[i] || b[i];
+}
+inline void xor_with(bitmap &a, const bitmap &b) {
+	for (size_t i = 0; i < a.size(); ++i)
+		a[i] = a[i] != b[i];
+}
+
+#endif
+
+int main() {
+	int i, r;
+	time_t st;
+	size_t sink = 0;
+
+	st = clock();
+	bitmap a, b;
+	for (i = 0; i < N; ++i) {
+		a.push_back(bit_at(1, i));
+		b.push_back(bit_at(2, i));
+	}
+	printf("push_back %.3fs\n", (double)(clock() - st) / CLOCKS_PER_SEC);
+
+	st = clock();
+	for (r = 0; r < R; ++r)
+		sink += count(a) + r;
+	printf("count     %.3fs\n", (double)(clock() - st) / CLOCKS_PER_SEC);
+
+	st = clock();
+	for (r = 0; r < R; ++r)
+		sink += scan(b);
+	printf("scan      %.3fs\n", (double)(clock() - st) / CLOCKS_PER_SEC);
+
+	st = clock();
+	for (r = 0; r < R; ++r) {
+		and_with(a, b);
+		or_with(a, b);
+		xor_with(a, b);
+	}
+	printf("and/or/xor %.3fs\n", (double)(clock() - st) / CLOCKS_PER_SEC);
+
+#if !defined(USE_LNI_VECTOR)
+	// the same workload as fixed-size std::bitset loops
+	auto ba = std::make_unique<std::bitset<N>>(), bb = std::make_unique<std::bitset<N>>();
+	for (i = 0; i < N; ++i) {
+		(*ba)[i] = bit_at(1, i);
+		(*bb)[i] = bit_at(2, i);
+	}
+
+	st = clock();
+	for (r = 0; r < R; ++r)
+		sink += ba->count() + r;
+	printf("bitset count     %.3fs\n", (double)(clock() - st) / CLOCKS_PER_SEC);
+
+	st = clock();
+	for (r = 0; r < R; ++r)
+		for (i = 0; i < N; ++i)
+			if ((*bb)[i])
+				sink += i;
+	printf("bitset scan      %.3fs\n", (double)(clock() - st) / CLOCKS_PER_SEC);
+
+	st = clock();
+	for (r = 0; r < R; ++r) {
+		*ba &= *bb;
+		*ba |= *bb;
+		*ba ^= *bb;
+	}
+	printf("bitset and/or/xor %.3fs\n", (double)(clock() - st) / CLOCKS_PER_SEC);
+#endif
+
+	printf("%zu\n", sink + a.size() + count(a));
+
+	return 0;
+}
@@ -0,0 +1,98 @@
+#include <cstdio>
+#include <ctime>
+#include <vector>
+#include "../capacity_hints.hpp"
+
+
+#if defined(USE_LNI_VECTOR)
+
+template <typename T>
+using vec = lni::hinted_vector<T>;
+
+#else
+
+template <typename T>
+using vec = std::vector<T>;
+
+#endif
+
+
+const int R = 2e5;
+const char *path = "capacity_hints.txt";
+
+unsigned long long reallocs;
+
+// each site builds vectors whose final size follows its own distribution
+template <typename V>
+int fill(V &v, int n) {
+	size_t cap = v.capacity();
+	for (int i = 0; i < n; ++i) {
+		v.push_back(i);
+		if (v.capacity() != cap) {
+			++reallocs;
+			cap = v.capacity();
+		}
+	}
+	return v[n / 2];
+}
+
+template <typename V>
+int site_small(unsigned x) { V v; return fill(v, 5 + x % 4); }
+template <typename V>
+int site_medium(unsigned x) { V v; return fill(v, 900 + x % 200); }
+template <typename V>
+int site_large(unsigned x) { V v; return fill(v, 20000 + x % 5000); }
+template <typename V>
+int site_wide(unsigned x) { V v; return fill(v, 10 + x % 3000); }
+
+// replays the same deterministic mix of construction sites
+template <typename V>
+unsigned long long replay() {
+	unsigned long long ans = 0;
+	unsigned x = 12345;
+	for (int r = 0; r < R; ++r) {
+		x = x * 1103515245 + 12345;
+		switch ((x >> 16) % 16) {
+			case 0: ans += site_large<V>(x >> 8); break;
+			case 1: case 2: case 3: ans += site_wide<V>(x >> 8); break;
+			case 4: case 5: case 6: case 7: ans += site_medium<V>(x >> 8); break;
+			default: ans += site_small<V>(x >> 8); break;
+		}
+	}
+	return ans;
+}
+
+int main() {
+	unsigned long long ans;
+	time_t st;
+
+#if defined(USE_LNI_VECTOR)
+	reallocs = 0;
+	st = clock();
+	ans = replay<lni::vector<int>>();
+	printf("no hints: %llu reallocations, %.3fs\n", reallocs, (double)(clock() - st) / CLOCKS_PER_SEC);
+#endif
+
+	// hinted_vector learns while this runs
+	reallocs = 0;
+	st = clock();
+	ans = replay<vec<int>>();
+	printf("cold: %llu reallocations, %.3fs\n", reallocs, (double)(clock() - st) / CLOCKS_PER_SEC);
+
+#if defined(USE_LNI_VECTOR)
+	// simulate a restart that starts from the exported table
+	lni::capacity_hints::save(path);
+	lni::capacity_hints::reset();
+	lni::capacity_hints::load(path);
+	remove(path);
+#endif
+
+	reallocs = 0;
+	st = clock();
+	ans += replay<vec<int>>();
+	printf("warm: %llu reallocations, %.3fs\n", reallocs, (double)(clock() - st) / CLOCKS_PER_SEC);
+
+	printf("%llu\n", ans);
+
+	return 0;
+}
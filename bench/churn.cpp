@@ -0,0 +1,41 @@
+#include <cstdio>
+#include <ctime>
+#include <vector>
+#include "../vector.hpp"
+
+
+#if defined(USE_LNI_VECTOR)
+
+template <typename T>
+using vec = lni::vector<T>;
+
+#else
+
+template <typename T>
+using vec = std::vector<T>;
+
+#endif
+
+
+const int R = 2e6;
+
+int main() {
+	int i, r, n;
+	time_t st;
+	unsigned long long ans = 0;
+
+	// short-lived vectors of similar sizes, created, filled and destroyed in a loop
+	st = clock();
+	for (r = 0; r < R; ++r) {
+		vec<int> v;
+		n = 16 + (r * 37) % 200;
+		for (i = 0; i < n; ++i)
+			v.push_back(i ^ r);
+		vec<int> w(std::move(v));
+		ans += w[n / 2] + w.size();
+	}
+	printf("%llu\n", ans);
+	printf("%.3fs\n", (double)(clock() - st) / CLOCKS_PER_SEC);
+
+	return 0;
+}
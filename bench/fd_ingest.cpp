@@ -0,0 +1,79 @@
+#include <cstdio>
+#include <ctime>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include "../vector.hpp"
+
+
+#if defined(USE_LNI_VECTOR)
+
+template <typename T>
+using vec = lni::vector<T>;
+
+#else
+
+template <typename T>
+using vec = std::vector<T>;
+
+#endif
+
+
+const int N = 5e7;
+const int CHUNK = 1 << 16;
+const char *path = "fd_ingest.bin";
+
+// the usual way: read() into a bounce buffer, then insert() it (two copies)
+template <typename V>
+void ingest_buffered(V &v, int fd) {
+	static int buf[CHUNK];
+	ssize_t n;
+	while ((n = read(fd, buf, sizeof(buf))) > 0)
+		v.insert(v.end(), buf, buf + n / sizeof(int));
+}
+
+int main() {
+	int i, fd;
+	time_t st;
+
+	// create the input file
+	{
+		vec<int> out;
+		for (i = 0; i < N; ++i)
+			out.push_back(i * 7);
+		FILE *f = fopen(path, "wb");
+		fwrite(out.data(), sizeof(int), out.size(), f);
+		fclose(f);
+	}
+
+	st = clock();
+	fd = open(path, O_RDONLY);
+	vec<int> v1;
+	ingest_buffered(v1, fd);
+	close(fd);
+	printf("read + insert %.3fs\n", (double)(clock() - st) / CLOCKS_PER_SEC);
+
+#if defined(USE_LNI_VECTOR)
+	st = clock();
+	fd = open(path, O_RDONLY);
+	vec<int> v2;
+	v2.read_into(fd);
+	close(fd);
+	printf("read_into     %.3fs\n", (double)(clock() - st) / CLOCKS_PER_SEC);
+
+	st = clock();
+	fd = open(path, O_RDONLY);
+	vec<int> v3;
+	while (v3.append_from_fd(fd, CHUNK * sizeof(int)) == CHUNK * sizeof(int))
+		;
+	close(fd);
+	printf("append_from_fd %.3fs\n", (double)(clock() - st) / CLOCKS_PER_SEC);
+
+	if (v2.size() != v1.size() || v3.size() != v1.size() || v2[N - 1] != v1[N - 1])
+		printf("mismatch!\n");
+#endif
+
+	unlink(path);
+
+	return 0;
+}
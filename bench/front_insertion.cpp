@@ -0,0 +1,71 @@
+#include <cstdio>
+#include <ctime>
+#include <deque>
+#include <vector>
+#include "../devector.hpp"
+#include "../vector.hpp"
+
+
+#if defined(USE_LNI_VECTOR)
+
+template <typename T>
+using deq = lni::devector<T>;
+template <typename T>
+using vec = lni::vector<T>;
+
+#else
+
+template <typename T>
+using deq = std::deque<T>;
+template <typename T>
+using vec = std::vector<T>;
+
+#endif
+
+
+const int N = 5e7;
+const int M = 1e5;
+
+int main() {
+	int i;
+	time_t st;
+	unsigned long long ans = 0;
+
+	// push_front only
+	st = clock();
+	{
+		deq<int> d;
+		for (i = 0; i < N; ++i)
+			d.push_front(i);
+		ans += d[N / 2];
+	}
+	printf("push_front %.3fs\n", (double)(clock() - st) / CLOCKS_PER_SEC);
+
+	// FIFO queue: push_back with a pop_front for every other element
+	st = clock();
+	{
+		deq<int> d;
+		for (i = 0; i < N; ++i) {
+			d.push_back(i);
+			if (i & 1) {
+				ans += d.front();
+				d.pop_front();
+			}
+		}
+	}
+	printf("queue      %.3fs\n", (double)(clock() - st) / CLOCKS_PER_SEC);
+
+	// what front insertion costs on a plain vector, with a much smaller M
+	st = clock();
+	{
+		vec<int> v;
+		for (i = 0; i < M; ++i)
+			v.insert(v.begin(), i);
+		ans += v[M / 2];
+	}
+	printf("vector insert(begin()) x%d %.3fs\n", M, (double)(clock() - st) / CLOCKS_PER_SEC);
+
+	printf("%llu\n", ans);
+
+	return 0;
+}
@@ -0,0 +1,81 @@
+#include <cstdio>
+#include <ctime>
+#include <vector>
+#include "../jagged_vector.hpp"
+#include "../vector.hpp"
+
+
+#if defined(USE_LNI_VECTOR)
+
+template <typename T>
+using vec = lni::vector<T>;
+
+#else
+
+template <typename T>
+using vec = std::vector<T>;
+
+#endif
+
+
+const int R = 5e6;
+const int S = 10;
+
+// adjacency-list-like row lengths, 0 to 15
+inline int row_len(int r) { return (r * 2654435761u >> 7) % 16; }
+
+int main() {
+	int i, r, s;
+	time_t st;
+	unsigned long long ans = 0;
+
+	st = clock();
+	vec<vec<int>> nested;
+	for (r = 0; r < R; ++r) {
+		nested.emplace_back();
+		for (i = row_len(r); i--;)
+			nested.back().push_back(r + i);
+	}
+	printf("nested build %.3fs\n", (double)(clock() - st) / CLOCKS_PER_SEC);
+
+	st = clock();
+	for (s = 0; s < S; ++s)
+		for (auto &row: nested)
+			for (auto n: row)
+				ans += n;
+	printf("nested scan  %.3fs\n", (double)(clock() - st) / CLOCKS_PER_SEC);
+
+	// heap bytes reachable through capacity(), not counting malloc headers
+	size_t bytes = nested.capacity() * sizeof(vec<int>), allocs = 1;
+	for (auto &row: nested) {
+		bytes += row.capacity() * sizeof(int);
+		allocs += row.capacity() != 0;
+	}
+	printf("nested bytes %zu (%zu live allocations)\n", bytes, allocs);
+
+#if defined(USE_LNI_VECTOR)
+	st = clock();
+	lni::jagged_vector<int> jagged;
+	for (r = 0; r < R; ++r) {
+		jagged.push_row();
+		for (i = row_len(r); i--;)
+			jagged.append(r + i);
+	}
+	printf("jagged build %.3fs\n", (double)(clock() - st) / CLOCKS_PER_SEC);
+
+	st = clock();
+	for (s = 0; s < S; ++s)
+		for (auto row: jagged)
+			for (auto n: row)
+				ans -= n;
+	printf("jagged scan  %.3fs\n", (double)(clock() - st) / CLOCKS_PER_SEC);
+
+	printf("jagged bytes %zu (2 live allocations)\n", jagged.memory_usage());
+	jagged.compact();
+	printf("jagged bytes after compact() %zu\n", jagged.memory_usage());
+#endif
+
+	printf("%llu\n", ans);
+
+	return 0;
+}
@@ -0,0 +1,66 @@
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include "../incremental_vector.hpp"
+#include "../vector.hpp"
+
+
+const int N = 5e7;
+
+// per-operation latency histogram with power-of-two nanosecond buckets
+struct histogram {
+	unsigned long long bucket[64] = {}, total = 0, max_ns = 0;
+
+	void add(unsigned long long ns) {
+		int b = 0;
+		while ((2ull << b) <= ns)
+			++b;
+		++bucket[b];
+		++total;
+		if (ns > max_ns)
+			max_ns = ns;
+	}
+
+	unsigned long long percentile(double p) const {
+		unsigned long long seen = 0, want = (unsigned long long)(total * p);
+		for (int b = 0; b < 64; ++b) {
+			seen += bucket[b];
+			if (seen > want)
+				return 2ull << b;
+		}
+		return max_ns;
+	}
+
+	void print(const char *name) const {
+		printf("* %s\n", name);
+		printf("p50 < %lluns, p99 < %lluns, p99.9 < %lluns, p99.99 < %lluns, max %lluns\n",
+		       percentile(0.5), percentile(0.99), percentile(0.999), percentile(0.9999), max_ns);
+		for (int b = 0; b < 64; ++b)
+			if (bucket[b])
+				printf("  [%llu, %llu)ns %llu\n", b ? 1ull << b : 0, 2ull << b, bucket[b]);
+	}
+};
+
+template <typename V>
+void run(const char *name) {
+	histogram h;
+	V v;
+	for (int i = 0; i < N; ++i) {
+		auto st = std::chrono::steady_clock::now();
+		v.push_back(i);
+		auto ed = std::chrono::steady_clock::now();
+		h.add(std::chrono::duration_cast<std::chrono::nanoseconds>(ed - st).count());
+	}
+	h.print(name);
+}
+
+int main() {
+#if defined(USE_LNI_VECTOR)
+	run<lni::vector<int>>("lni::vector");
+	run<lni::incremental_vector<int>>("lni::incremental_vector");
+#else
+	run<std::vector<int>>("std::vector");
+#endif
+
+	return 0;
+}
@@ -0,0 +1,64 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <thread>
+#include <vector>
+#include "../vector.hpp"
+
+
+#if defined(USE_LNI_VECTOR)
+
+template <typename T>
+using vec = lni::vector<T>;
+
+#else
+
+template <typename T>
+using vec = std::vector<T>;
+
+#endif
+
+
+// wall-clock time, since the threaded sorts would otherwise be billed once per core
+inline double now() {
+	timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+template <typename V, typename F>
+void run(const char *name, const V &inp, V &v, F sort) {
+	v = inp;
+	double st = now();
+	sort(v);
+	printf("%-24s %.3fs%s\n", name, now() - st, std::is_sorted(v.begin(), v.end()) ? "" : " (NOT SORTED)");
+}
+
+// usage: ./lni_sort [N], N defaults to 1e7 (e.g. ./lni_sort 1e9 for the large case)
+int main(int argc, char **argv) {
+	size_t i, n = argc > 1 ? (size_t)atof(argv[1]) : 10000000;
+	unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+
+	vec<unsigned> inp, v;
+	unsigned x = 233;
+	for (i = 0; i < n; ++i) {
+		x = x * 1103515245 + 12345;
+		inp.push_back(x ^ (x >> 16));
+	}
+	printf("N = %zu, %u threads\n", n, threads);
+
+	run("std::sort", inp, v, [](vec<unsigned> &a) { std::sort(a.begin(), a.end()); });
+	run("std::stable_sort", inp, v, [](vec<unsigned> &a) { std::stable_sort(a.begin(), a.end()); });
+
+#if defined(USE_LNI_VECTOR)
+	run("sort()", inp, v, [](vec<unsigned> &a) { a.sort(); });
+	run("stable_sort()", inp, v, [](vec<unsigned> &a) { a.stable_sort(); });
+	run("radix_sort()", inp, v, [](vec<unsigned> &a) { a.radix_sort(); });
+	run("sort(threads)", inp, v, [&](vec<unsigned> &a) { a.sort(std::less<unsigned>(), threads); });
+	run("stable_sort(threads)", inp, v, [&](vec<unsigned> &a) { a.stable_sort(std::less<unsigned>(), threads); });
+	run("radix_sort(threads)", inp, v, [&](vec<unsigned> &a) { a.radix_sort(threads); });
+#endif
+
+	return 0;
+}
@@ -18,6 +18,12 @@ echo "* lni::vector"
 ./lni_$1
 echo ""
 
+if make -s lni_cached_$1 2>/dev/null; then
+	echo "* lni::vector (CATZ_VECTOR_BUFFER_CACHE)"
+	./lni_cached_$1
+	echo ""
+fi
+
 echo "* std::vector"
 ./std_$1
 
@@ -0,0 +1,508 @@
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#ifndef CATZ_BIT_VECTOR
+#define CATZ_BIT_VECTOR
+
+namespace lni {
+
+namespace detail {
+
+struct bit_and {
+  static inline uint64_t apply(uint64_t a, uint64_t b) { return a & b; }
+#if defined(__AVX2__)
+  static inline __m256i apply(__m256i a, __m256i b) { return _mm256_and_si256(a, b); }
+#elif defined(__SSE2__)
+  static inline __m128i apply(__m128i a, __m128i b) { return _mm_and_si128(a, b); }
+#endif
+};
+
+struct bit_or {
+  static inline uint64_t apply(uint64_t a, uint64_t b) { return a | b; }
+#if defined(__AVX2__)
+  static inline __m256i apply(__m256i a, __m256i b) { return _mm256_or_si256(a, b); }
+#elif defined(__SSE2__)
+  static inline __m128i apply(__m128i a, __m128i b) { return _mm_or_si128(a, b); }
+#endif
+};
+
+struct bit_xor {
+  static inline uint64_t apply(uint64_t a, uint64_t b) { return a ^ b; }
+#if defined(__AVX2__)
+  static inline __m256i apply(__m256i a, __m256i b) { return _mm256_xor_si256(a, b); }
+#elif defined(__SSE2__)
+  static inline __m128i apply(__m128i a, __m128i b) { return _mm_xor_si128(a, b); }
+#endif
+};
+
+// dst[i] = Op(dst[i], src[i]) for n words, 256 bits at a time with -mavx2, 128 with SSE2
+template <typename Op>
+inline void bitwise_words(uint64_t *dst, const uint64_t *src, size_t n) {
+  size_t i = 0;
+#if defined(__AVX2__)
+  for (; i + 4 <= n; i += 4) {
+    __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(dst + i));
+    __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), Op::apply(a, b));
+  }
+#elif defined(__SSE2__)
+  for (; i + 2 <= n; i += 2) {
+    __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dst + i));
+    __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), Op::apply(a, b));
+  }
+#endif
+  for (; i < n; ++i) {
+    dst[i] = Op::apply(dst[i], src[i]);
+  }
+}
+
+}  // namespace detail
+
+// Bit-packed vector of bools: 64 per word, same factor-4 growth as lni::vector.
+// lni::vector<bool> itself keeps one byte per element and the full vector interface; use this
+// one for bitmaps. Invariant: every bit at or past vec_sz is zero, so count/find/compare can
+// work on whole words.
+class bit_vector {
+ public:
+  // types:
+  typedef bool value_type;
+  typedef uint64_t word_type;
+  typedef bool const_reference;
+  typedef size_t size_type;
+  typedef ptrdiff_t difference_type;
+
+  static constexpr size_type word_bits = 64;
+  static constexpr size_type npos = std::numeric_limits<size_type>::max();
+
+  class reference {
+   public:
+    reference(word_type *w, word_type m) noexcept : word(w), mask(m) {}
+    reference(const reference &) noexcept = default;
+
+    inline operator bool() const noexcept { return (*word & mask) != 0; }
+
+    inline reference &operator=(bool val) noexcept {
+      if (val) {
+        *word |= mask;
+      } else {
+        *word &= ~mask;
+      }
+      return *this;
+    }
+
+    inline reference &operator=(const reference &rhs) noexcept {
+      return *this = static_cast<bool>(rhs);
+    }
+
+    inline bool operator~() const noexcept { return !static_cast<bool>(*this); }
+
+    inline void flip() noexcept { *word ^= mask; }
+
+   private:
+    word_type *word;
+    word_type mask;
+  };
+
+  template <bool Const>
+  class bit_iterator {
+   public:
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef bool value_type;
+    typedef ptrdiff_t difference_type;
+    typedef void pointer;
+    typedef std::conditional_t<Const, bool, bit_vector::reference> reference;
+    typedef std::conditional_t<Const, const word_type, word_type> word_ref;
+
+    bit_iterator() noexcept = default;
+    bit_iterator(word_ref *w, size_type p) noexcept : words(w), pos(p) {}
+    template <bool C>
+      requires(Const && !C)
+    bit_iterator(const bit_iterator<C> &other) noexcept : words(other.words), pos(other.pos) {}
+
+    inline reference operator*() const noexcept {
+      if constexpr (Const) {
+        return (words[pos / word_bits] >> (pos % word_bits)) & 1;
+      } else {
+        return reference(words + pos / word_bits, word_type(1) << (pos % word_bits));
+      }
+    }
+
+    inline reference operator[](difference_type n) const noexcept { return *(*this + n); }
+
+    inline bit_iterator &operator++() noexcept {
+      ++pos;
+      return *this;
+    }
+    inline bit_iterator operator++(int) noexcept { return bit_iterator(words, pos++); }
+    inline bit_iterator &operator--() noexcept {
+      --pos;
+      return *this;
+    }
+    inline bit_iterator operator--(int) noexcept { return bit_iterator(words, pos--); }
+    inline bit_iterator &operator+=(difference_type n) noexcept {
+      pos += n;
+      return *this;
+    }
+    inline bit_iterator &operator-=(difference_type n) noexcept {
+      pos -= n;
+      return *this;
+    }
+    inline bit_iterator operator+(difference_type n) const noexcept {
+      return bit_iterator(words, pos + n);
+    }
+    inline bit_iterator operator-(difference_type n) const noexcept {
+      return bit_iterator(words, pos - n);
+    }
+    friend inline bit_iterator operator+(difference_type n, const bit_iterator &it) noexcept {
+      return it + n;
+    }
+    inline difference_type operator-(const bit_iterator &rhs) const noexcept {
+      return static_cast<difference_type>(pos) - static_cast<difference_type>(rhs.pos);
+    }
+    inline bool operator==(const bit_iterator &rhs) const noexcept { return pos == rhs.pos; }
+    inline auto operator<=>(const bit_iterator &rhs) const noexcept { return pos <=> rhs.pos; }
+
+   private:
+    friend class bit_iterator<!Const>;
+    word_ref *words = nullptr;
+    size_type pos = 0;
+  };
+
+  typedef bit_iterator<false> iterator;
+  typedef bit_iterator<true> const_iterator;
+  typedef std::reverse_iterator<iterator> reverse_iterator;
+  typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+  bit_vector() noexcept {}
+
+  inline explicit bit_vector(size_type n, bool value = false) {
+    rsrv_sz = n << 2;
+    reallocate();
+    fill_bits(0, n, value);
+    vec_sz = n;
+  }
+
+  inline bit_vector(std::initializer_list<bool> lst) {
+    rsrv_sz = lst.size() << 2;
+    reallocate();
+    for (bool b : lst) {
+      push_back(b);
+    }
+  }
+
+  inline bit_vector(const bit_vector &other) {
+    rsrv_sz = other.vec_sz << 2;
+    reallocate();
+    if (other.vec_sz) {
+      memcpy(arr, other.arr, words_for(other.vec_sz) * sizeof(word_type));
+    }
+    vec_sz = other.vec_sz;
+  }
+
+  inline bit_vector(bit_vector &&other) noexcept { swap(other); }
+
+  ~bit_vector() { operator delete(arr); }
+
+  inline bit_vector &operator=(const bit_vector &other) {
+    if (this != &other) {
+      clear();
+      ensure_capacity(other.vec_sz);
+      if (other.vec_sz) {
+        memcpy(arr, other.arr, words_for(other.vec_sz) * sizeof(word_type));
+      }
+      vec_sz = other.vec_sz;
+    }
+    return *this;
+  }
+
+  inline bit_vector &operator=(bit_vector &&other) noexcept {
+    if (this != &other) {
+      bit_vector tmp(std::move(other));
+      swap(tmp);
+    }
+    return *this;
+  }
+
+  inline bit_vector &operator=(std::initializer_list<bool> lst) {
+    clear();
+    ensure_capacity(lst.size());
+    for (bool b : lst) {
+      push_back(b);
+    }
+    return *this;
+  }
+
+  inline void assign(size_type count, bool value) {
+    clear();
+    ensure_capacity(count);
+    fill_bits(0, count, value);
+    vec_sz = count;
+  }
+
+  inline iterator begin() noexcept { return iterator(arr, 0); }
+
+  inline const_iterator begin() const noexcept { return const_iterator(arr, 0); }
+
+  inline const_iterator cbegin() const noexcept { return const_iterator(arr, 0); }
+
+  inline iterator end() noexcept { return iterator(arr, vec_sz); }
+
+  inline const_iterator end() const noexcept { return const_iterator(arr, vec_sz); }
+
+  inline const_iterator cend() const noexcept { return const_iterator(arr, vec_sz); }
+
+  inline reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+
+  inline const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(end()); }
+
+  inline reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+
+  inline const_reverse_iterator crend() const noexcept { return const_reverse_iterator(begin()); }
+
+  inline bool empty() const noexcept { return vec_sz == 0; }
+
+  inline size_type size() const noexcept { return vec_sz; }
+
+  inline size_type max_size() const noexcept { return std::numeric_limits<size_type>::max(); }
+
+  inline size_type capacity() const noexcept { return rsrv_sz; }
+
+  // number of words backing size() bits
+  inline size_type num_words() const noexcept { return words_for(vec_sz); }
+
+  inline void reserve(size_type _sz) {
+    if (_sz > rsrv_sz) {
+      rsrv_sz = _sz;
+      reallocate();
+    }
+  }
+
+  inline void shrink_to_fit() {
+    if (words_for(rsrv_sz) != words_for(vec_sz)) {
+      rsrv_sz = vec_sz;
+      reallocate();
+    }
+  }
+
+  inline reference operator[](size_type idx) noexcept {
+    return reference(arr + idx / word_bits, word_type(1) << (idx % word_bits));
+  }
+
+  inline const_reference operator[](size_type idx) const noexcept { return test(idx); }
+
+  inline reference at(size_type pos) {
+    return (pos < vec_sz) ? (*this)[pos]
+                          : throw std::out_of_range("accessed position is out of range");
+  }
+
+  inline const_reference at(size_type pos) const {
+    return (pos < vec_sz) ? test(pos)
+                          : throw std::out_of_range("accessed position is out of range");
+  }
+
+  inline bool test(size_type idx) const noexcept {
+    return (arr[idx / word_bits] >> (idx % word_bits)) & 1;
+  }
+
+  inline reference front() noexcept { return (*this)[0]; }
+
+  inline const_reference front() const noexcept { return test(0); }
+
+  inline reference back() noexcept { return (*this)[vec_sz - 1]; }
+
+  inline const_reference back() const noexcept { return test(vec_sz - 1); }
+
+  inline word_type *data() noexcept { return arr; }
+
+  inline const word_type *data() const noexcept { return arr; }
+
+  inline void emplace_back(bool val) { push_back(val); }
+
+  inline void push_back(bool val) {
+    if (vec_sz == rsrv_sz) {
+      rsrv_sz = rsrv_sz ? rsrv_sz << 2 : word_bits;
+      reallocate();
+    }
+    arr[vec_sz / word_bits] |= word_type(val) << (vec_sz % word_bits);
+    ++vec_sz;
+  }
+
+  inline void pop_back() noexcept {
+    --vec_sz;
+    arr[vec_sz / word_bits] &= ~(word_type(1) << (vec_sz % word_bits));
+  }
+
+  inline void swap(bit_vector &rhs) noexcept {
+    std::swap(vec_sz, rhs.vec_sz);
+    std::swap(rsrv_sz, rhs.rsrv_sz);
+    std::swap(arr, rhs.arr);
+  }
+
+  inline void clear() noexcept {
+    if (arr) {
+      memset(arr, 0, words_for(vec_sz) * sizeof(word_type));
+    }
+    vec_sz = 0;
+  }
+
+  inline void resize(size_type sz, bool c = false) {
+    if (sz > vec_sz) {
+      if (sz > rsrv_sz) {
+        rsrv_sz = sz;
+        reallocate();
+      }
+      fill_bits(vec_sz, sz, c);
+    } else {
+      fill_bits(sz, vec_sz, false);
+    }
+    vec_sz = sz;
+  }
+
+  inline void flip() noexcept {
+    size_type nw = words_for(vec_sz);
+    for (size_type i = 0; i < nw; ++i) {
+      arr[i] = ~arr[i];
+    }
+    clear_tail();
+  }
+
+  inline void flip(size_type pos) noexcept {
+    arr[pos / word_bits] ^= word_type(1) << (pos % word_bits);
+  }
+
+  // number of set bits; std::popcount is a single popcnt only with -mpopcnt (or -march=native)
+  inline size_type count() const noexcept {
+    size_type nw = words_for(vec_sz), cnt = 0;
+    for (size_type i = 0; i < nw; ++i) {
+      cnt += static_cast<size_type>(std::popcount(arr[i]));
+    }
+    return cnt;
+  }
+
+  inline bool any() const noexcept { return find_first() != npos; }
+
+  inline bool none() const noexcept { return find_first() == npos; }
+
+  // index of the first set bit, or npos
+  inline size_type find_first() const noexcept { return find_from(0); }
+
+  // index of the first set bit after pos, or npos
+  inline size_type find_next(size_type pos) const noexcept {
+    return pos + 1 < vec_sz ? find_from(pos + 1) : npos;
+  }
+
+  // rhs is treated as zero-extended (or truncated) to size(); size() never changes
+  inline bit_vector &operator&=(const bit_vector &rhs) noexcept {
+    size_type nw = words_for(vec_sz), rw = words_for(rhs.vec_sz);
+    if (rw < nw) {
+      detail::bitwise_words<detail::bit_and>(arr, rhs.arr, rw);
+      memset(arr + rw, 0, (nw - rw) * sizeof(word_type));
+    } else {
+      detail::bitwise_words<detail::bit_and>(arr, rhs.arr, nw);
+    }
+    return *this;
+  }
+
+  inline bit_vector &operator|=(const bit_vector &rhs) noexcept {
+    detail::bitwise_words<detail::bit_or>(arr, rhs.arr, std::min(num_words(), rhs.num_words()));
+    clear_tail();
+    return *this;
+  }
+
+  inline bit_vector &operator^=(const bit_vector &rhs) noexcept {
+    detail::bitwise_words<detail::bit_xor>(arr, rhs.arr, std::min(num_words(), rhs.num_words()));
+    clear_tail();
+    return *this;
+  }
+
+  inline bool operator==(const bit_vector &rhs) const noexcept {
+    return vec_sz == rhs.vec_sz &&
+           (vec_sz == 0 || memcmp(arr, rhs.arr, num_words() * sizeof(word_type)) == 0);
+  }
+  inline bool operator!=(const bit_vector &rhs) const noexcept { return !(*this == rhs); }
+
+ private:
+  static inline size_type words_for(size_type bits) noexcept {
+    return (bits + word_bits - 1) / word_bits;
+  }
+  inline void ensure_capacity(size_type required_sz) {
+    if (required_sz > rsrv_sz) {
+      rsrv_sz = required_sz << 2;
+      reallocate();
+    }
+  }
+  // rounds rsrv_sz up to whole words; words past the used ones are zeroed to keep the invariant
+  inline void reallocate() {
+    size_type nw = words_for(rsrv_sz), used = words_for(vec_sz);
+    word_type *tarr = nullptr;
+    if (nw) {
+      tarr = static_cast<word_type *>(operator new(nw * sizeof(word_type)));
+      if (used) {
+        memcpy(tarr, arr, used * sizeof(word_type));
+      }
+      memset(tarr + used, 0, (nw - used) * sizeof(word_type));
+    }
+    operator delete(arr);
+    arr = tarr;
+    rsrv_sz = nw * word_bits;
+  }
+  inline void clear_tail() noexcept {
+    if (vec_sz % word_bits) {
+      arr[vec_sz / word_bits] &= (word_type(1) << (vec_sz % word_bits)) - 1;
+    }
+  }
+  // sets bits [first, last) to val, whole words at a time where possible
+  inline void fill_bits(size_type first, size_type last, bool val) noexcept {
+    if (first >= last) {
+      return;
+    }
+    size_type fw = first / word_bits, lw = (last - 1) / word_bits;
+    word_type head = ~word_type(0) << (first % word_bits);
+    word_type tail = ~word_type(0) >> (word_bits - 1 - (last - 1) % word_bits);
+    if (fw == lw) {
+      head &= tail;
+    }
+    arr[fw] = val ? (arr[fw] | head) : (arr[fw] & ~head);
+    if (fw != lw) {
+      if (lw > fw + 1) {
+        memset(arr + fw + 1, val ? 0xFF : 0, (lw - fw - 1) * sizeof(word_type));
+      }
+      arr[lw] = val ? (arr[lw] | tail) : (arr[lw] & ~tail);
+    }
+  }
+  inline size_type find_from(size_type pos) const noexcept {
+    size_type w = pos / word_bits, nw = words_for(vec_sz);
+    if (w >= nw) {
+      return npos;
+    }
+    word_type cur = arr[w] & (~word_type(0) << (pos % word_bits));
+    while (!cur) {
+      if (++w == nw) {
+        return npos;
+      }
+      cur = arr[w];
+    }
+    return w * word_bits + static_cast<size_type>(std::countr_zero(cur));
+  }
+
+  size_type rsrv_sz = 0, vec_sz = 0;
+  word_type *arr = nullptr;
+};
+
+}  // namespace lni
+
+#endif  // CATZ_BIT_VECTOR
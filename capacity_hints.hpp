@@ -0,0 +1,247 @@
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <source_location>
+#include <sstream>
+#include <string>
+#include <utility>
+
+#include "vector.hpp"
+
+#ifndef CATZ_CAPACITY_HINTS
+#define CATZ_CAPACITY_HINTS
+
+namespace lni {
+
+// Process-wide, lock-free table of final vector sizes per construction site.
+// Sites are keyed by a hash of file:line:column, so a table saved by one run of a binary can be
+// loaded by the next one to start with learned capacities. Each site keeps a log-linear
+// histogram (4 buckets per power of two, so a hint overshoots by at most 25%).
+class capacity_hints {
+ public:
+  static constexpr size_t num_sites = 1024;
+  static constexpr size_t num_buckets = 188;  // sizes up to 2^48
+  static constexpr uint32_t min_samples = 16;
+
+  static inline uint64_t site_key(const std::source_location &site) noexcept {
+    uint64_t h = 14695981039346656037ull;
+    for (const char *c = site.file_name(); *c; ++c) {
+      h = (h ^ static_cast<unsigned char>(*c)) * 1099511628211ull;
+    }
+    h = (h ^ site.line()) * 1099511628211ull;
+    h = (h ^ site.column()) * 1099511628211ull;
+    return h ? h : 1;
+  }
+
+  // learned capacity for a site, 0 while it has fewer than min_samples samples
+  static inline size_t hint(uint64_t key) noexcept {
+    slot *s = find(key, false);
+    return s ? s->hint.load(std::memory_order_relaxed) : 0;
+  }
+
+  static inline void record(uint64_t key, size_t final_sz) noexcept {
+    slot *s = find(key, true);
+    if (!s) {
+      return;
+    }
+    s->buckets[bucket_of(final_sz)].fetch_add(1, std::memory_order_relaxed);
+    uint32_t n = s->count.fetch_add(1, std::memory_order_relaxed) + 1;
+    if (n == min_samples || (n > min_samples && (n & 63) == 0)) {
+      update_hint(*s);
+    }
+  }
+
+  // fraction of past sizes the hint must cover, 0.9 by default
+  static inline void set_percentile(double p) noexcept {
+    permille().store(static_cast<uint32_t>(p * 1000), std::memory_order_relaxed);
+  }
+
+  // one line per site: key, sample count, then bucket:count pairs
+  static inline bool save(const std::string &path) {
+    std::ofstream out(path);
+    if (!out) {
+      return false;
+    }
+    out << "# lni capacity hints v1\n";
+    for (slot &s : sites()) {
+      uint64_t key = s.key.load(std::memory_order_acquire);
+      if (!key) {
+        continue;
+      }
+      out << std::hex << key << std::dec << " " << s.count.load(std::memory_order_relaxed);
+      for (size_t b = 0; b < num_buckets; ++b) {
+        uint32_t c = s.buckets[b].load(std::memory_order_relaxed);
+        if (c) {
+          out << " " << b << ":" << c;
+        }
+      }
+      out << "\n";
+    }
+    return static_cast<bool>(out);
+  }
+
+  // merges a saved table into the current one
+  static inline bool load(const std::string &path) {
+    std::ifstream in(path);
+    if (!in) {
+      return false;
+    }
+    std::string line;
+    while (std::getline(in, line)) {
+      if (line.empty() || line[0] == '#') {
+        continue;
+      }
+      std::istringstream ls(line);
+      uint64_t key;
+      uint32_t count;
+      if (!(ls >> std::hex >> key >> std::dec >> count) || !key) {
+        continue;
+      }
+      slot *s = find(key, true);
+      if (!s) {
+        continue;
+      }
+      size_t b;
+      char colon;
+      uint32_t c;
+      while (ls >> b >> colon >> c) {
+        if (b < num_buckets) {
+          s->buckets[b].fetch_add(c, std::memory_order_relaxed);
+        }
+      }
+      if (s->count.fetch_add(count, std::memory_order_relaxed) + count >= min_samples) {
+        update_hint(*s);
+      }
+    }
+    return true;
+  }
+
+  // forgets everything; not safe to call while other threads record
+  static inline void reset() noexcept {
+    for (slot &s : sites()) {
+      s.key.store(0, std::memory_order_relaxed);
+      s.hint.store(0, std::memory_order_relaxed);
+      s.count.store(0, std::memory_order_relaxed);
+      for (auto &b : s.buckets) {
+        b.store(0, std::memory_order_relaxed);
+      }
+    }
+  }
+
+ private:
+  struct slot {
+    std::atomic<uint64_t> key;
+    std::atomic<uint64_t> hint;
+    std::atomic<uint32_t> count;
+    std::atomic<uint32_t> buckets[num_buckets];
+  };
+
+  static inline slot (&sites() noexcept)[num_sites] {
+    static slot table[num_sites];
+    return table;
+  }
+  static inline std::atomic<uint32_t> &permille() noexcept {
+    static std::atomic<uint32_t> p{900};
+    return p;
+  }
+
+  // linear probing over a short window; returns nullptr if the site is unknown (or the
+  // window is full when claiming)
+  static inline slot *find(uint64_t key, bool claim) noexcept {
+    for (size_t i = 0; i < 16; ++i) {
+      slot &s = sites()[(key + i) % num_sites];
+      uint64_t cur = s.key.load(std::memory_order_acquire);
+      if (cur == key) {
+        return &s;
+      }
+      if (cur == 0) {
+        if (!claim) {
+          return nullptr;
+        }
+        if (s.key.compare_exchange_strong(cur, key, std::memory_order_acq_rel) || cur == key) {
+          return &s;
+        }
+      }
+    }
+    return nullptr;
+  }
+
+  static inline size_t bucket_of(size_t sz) noexcept {
+    if (sz < 4) {
+      return sz;
+    }
+    size_t e = static_cast<size_t>(std::bit_width(sz)) - 1;
+    size_t b = (e - 1) * 4 + ((sz >> (e - 2)) & 3);
+    return b < num_buckets ? b : num_buckets - 1;
+  }
+
+  // largest size that falls into bucket b
+  static inline size_t bucket_max(size_t b) noexcept {
+    if (b < 4) {
+      return b;
+    }
+    size_t e = b / 4 + 1, m = b % 4;
+    return ((4 + m + 1) << (e - 2)) - 1;
+  }
+
+  static inline void update_hint(slot &s) noexcept {
+    uint64_t total = 0;
+    for (auto &b : s.buckets) {
+      total += b.load(std::memory_order_relaxed);
+    }
+    uint64_t want = total * permille().load(std::memory_order_relaxed) / 1000, seen = 0;
+    for (size_t b = 0; b < num_buckets; ++b) {
+      seen += s.buckets[b].load(std::memory_order_relaxed);
+      if (seen > want || seen == total) {
+        s.hint.store(bucket_max(b), std::memory_order_relaxed);
+        return;
+      }
+    }
+  }
+};
+
+// lni::vector that pre-reserves the capacity learned for its construction site and reports its
+// final size back on destruction. Construct it without arguments to tag the caller's line.
+template <typename T>
+class hinted_vector : public vector<T> {
+ public:
+  explicit hinted_vector(std::source_location site = std::source_location::current())
+      : key(capacity_hints::site_key(site)) {
+    size_t h = capacity_hints::hint(key);
+    if (h) {
+      this->reserve(h);
+    }
+  }
+
+  hinted_vector(const hinted_vector<T> &other) = default;
+
+  // the moved-from vector no longer reports, so its site does not learn a size of 0
+  hinted_vector(hinted_vector<T> &&other) noexcept
+      : vector<T>(std::move(other)), key(std::exchange(other.key, 0)) {}
+
+  ~hinted_vector() {
+    if (key) {
+      capacity_hints::record(key, this->size());
+    }
+  }
+
+  hinted_vector<T> &operator=(const hinted_vector<T> &other) {
+    vector<T>::operator=(other);
+    return *this;
+  }
+
+  hinted_vector<T> &operator=(hinted_vector<T> &&other) noexcept {
+    vector<T>::operator=(std::move(other));
+    other.key = 0;
+    return *this;
+  }
+
+ private:
+  uint64_t key;
+};
+
+}  // namespace lni
+
+#endif  // CATZ_CAPACITY_HINTS
@@ -0,0 +1,269 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "vector.hpp"
+
+#ifndef CATZ_DEVECTOR
+#define CATZ_DEVECTOR
+
+namespace lni {
+
+// Double-ended lni::vector: the elements live in arr[off, off + vec_sz) with spare capacity on
+// both sides, so push_front/pop_front are amortized O(1) and data() stays contiguous.
+// When one end runs out of room, the elements are re-centered in place if the other end has at
+// least size() free slots, otherwise the buffer grows by 4x and all of the new room goes to the
+// end that ran out.
+template <typename T>
+class devector {
+ public:
+  // types:
+  typedef T value_type;
+  typedef T &reference;
+  typedef const T &const_reference;
+  typedef T *pointer;
+  typedef const T *const_pointer;
+  typedef T *iterator;
+  typedef const T *const_iterator;
+  typedef std::reverse_iterator<iterator> reverse_iterator;
+  typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+  typedef ptrdiff_t difference_type;
+  typedef size_t size_type;
+
+  devector() noexcept {}
+
+  inline devector(size_type n, const T &value) {
+    rsrv_sz = n << 2;
+    arr = detail::allocate_buffer<T>(rsrv_sz);
+    off = (rsrv_sz - n) / 2;
+    std::uninitialized_fill_n(arr + off, n, value);
+    vec_sz = n;
+  }
+
+  inline devector(std::initializer_list<T> lst) { allocate_and_copy(lst.size(), lst.begin()); }
+
+  inline devector(const devector<T> &other) { allocate_and_copy(other.vec_sz, other.begin()); }
+
+  inline devector(devector<T> &&other) noexcept { swap(other); }
+
+  ~devector() {
+    clear();
+    detail::deallocate_buffer(arr, rsrv_sz);
+  }
+
+  inline devector<T> &operator=(const devector<T> &other) {
+    if (this != &other) {
+      devector<T> tmp(other);
+      swap(tmp);
+    }
+    return *this;
+  }
+
+  inline devector<T> &operator=(devector<T> &&other) noexcept {
+    if (this != &other) {
+      devector<T> tmp(std::move(other));
+      swap(tmp);
+    }
+    return *this;
+  }
+
+  inline iterator begin() noexcept { return arr + off; }
+
+  inline const_iterator begin() const noexcept { return arr + off; }
+
+  inline const_iterator cbegin() const noexcept { return arr + off; }
+
+  inline iterator end() noexcept { return arr + off + vec_sz; }
+
+  inline const_iterator end() const noexcept { return arr + off + vec_sz; }
+
+  inline const_iterator cend() const noexcept { return arr + off + vec_sz; }
+
+  inline reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+
+  inline const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(end()); }
+
+  inline reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+
+  inline const_reverse_iterator crend() const noexcept { return const_reverse_iterator(begin()); }
+
+  inline bool empty() const noexcept { return vec_sz == 0; }
+
+  inline size_type size() const noexcept { return vec_sz; }
+
+  inline size_type capacity() const noexcept { return rsrv_sz; }
+
+  // free slots before begin() and after end()
+  inline size_type front_free() const noexcept { return off; }
+
+  inline size_type back_free() const noexcept { return rsrv_sz - off - vec_sz; }
+
+  // like lni::vector::reserve, the extra room goes to the back
+  inline void reserve(size_type _sz) {
+    if (_sz > rsrv_sz) {
+      reallocate(_sz, off);
+    }
+  }
+
+  inline reference operator[](size_type idx) noexcept { return arr[off + idx]; }
+
+  inline const_reference operator[](size_type idx) const noexcept { return arr[off + idx]; }
+
+  inline reference at(size_type pos) {
+    return (pos < vec_sz) ? arr[off + pos]
+                          : throw std::out_of_range("accessed position is out of range");
+  }
+
+  inline const_reference at(size_type pos) const {
+    return (pos < vec_sz) ? arr[off + pos]
+                          : throw std::out_of_range("accessed position is out of range");
+  }
+
+  inline reference front() noexcept { return arr[off]; }
+
+  inline const_reference front() const noexcept { return arr[off]; }
+
+  inline reference back() noexcept { return arr[off + vec_sz - 1]; }
+
+  inline const_reference back() const noexcept { return arr[off + vec_sz - 1]; }
+
+  inline T *data() noexcept { return arr + off; }
+
+  inline const T *data() const noexcept { return arr + off; }
+
+  // args may refer to an element of this devector (e.g. push_back(front())), so when room has
+  // to be made, the new element is built before the old ones move
+  template <class... Args>
+  inline void emplace_back(Args &&...args) {
+    if (off + vec_sz == rsrv_sz) {
+      T tmp(std::forward<Args>(args)...);
+      make_room_back();
+      new (arr + off + vec_sz) T(std::move(tmp));
+    } else {
+      new (arr + off + vec_sz) T(std::forward<Args>(args)...);
+    }
+    ++vec_sz;
+  }
+
+  inline void push_back(const T &val) { emplace_back(val); }
+
+  inline void push_back(T &&val) { emplace_back(std::move(val)); }
+
+  template <class... Args>
+  inline void emplace_front(Args &&...args) {
+    if (off == 0) {
+      T tmp(std::forward<Args>(args)...);
+      make_room_front();
+      new (arr + off - 1) T(std::move(tmp));
+    } else {
+      new (arr + off - 1) T(std::forward<Args>(args)...);
+    }
+    --off;
+    ++vec_sz;
+  }
+
+  inline void push_front(const T &val) { emplace_front(val); }
+
+  inline void push_front(T &&val) { emplace_front(std::move(val)); }
+
+  inline void pop_back() {
+    --vec_sz;
+    if constexpr (!std::is_trivially_destructible<T>::value) {
+      arr[off + vec_sz].~T();
+    }
+  }
+
+  inline void pop_front() {
+    if constexpr (!std::is_trivially_destructible<T>::value) {
+      arr[off].~T();
+    }
+    ++off;
+    --vec_sz;
+  }
+
+  inline void swap(devector<T> &rhs) noexcept {
+    std::swap(vec_sz, rhs.vec_sz);
+    std::swap(rsrv_sz, rhs.rsrv_sz);
+    std::swap(off, rhs.off);
+    std::swap(arr, rhs.arr);
+  }
+
+  // keeps the buffer; the next push_front re-centers for free since there is nothing to move
+  inline void clear() noexcept {
+    if constexpr (!std::is_trivially_destructible<T>::value) {
+      std::destroy(arr + off, arr + off + vec_sz);
+    }
+    off = 0;
+    vec_sz = 0;
+  }
+
+  inline bool operator==(const devector<T> &rhs) const {
+    return vec_sz == rhs.vec_sz && std::equal(begin(), end(), rhs.begin());
+  }
+  inline bool operator!=(const devector<T> &rhs) const { return !(*this == rhs); }
+
+ private:
+  inline void make_room_back() {
+    if (off >= vec_sz && off) {
+      recenter();
+    } else {
+      size_type n = rsrv_sz ? rsrv_sz << 2 : 4;
+      reallocate(n, off);
+    }
+  }
+  inline void make_room_front() {
+    size_type back = rsrv_sz - vec_sz;
+    if (back >= vec_sz && back > 1) {
+      recenter();
+    } else {
+      size_type n = rsrv_sz ? rsrv_sz << 2 : 4;
+      reallocate(n, n - vec_sz - back);
+    }
+  }
+  // slides the elements to the middle of the buffer; the caller ensures the moved distance is
+  // paid for by at least size() / 2 cheap operations on each end
+  inline void recenter() {
+    size_type noff = (rsrv_sz - vec_sz) / 2;
+    if constexpr (std::is_trivially_copyable<T>::value) {
+      memmove(arr + noff, arr + off, vec_sz * sizeof(T));
+    } else if (noff < off) {
+      for (size_type i = 0; i < vec_sz; ++i) {
+        new (arr + noff + i) T(std::move(arr[off + i]));
+        arr[off + i].~T();
+      }
+    } else {
+      for (size_type i = vec_sz; i-- > 0;) {
+        new (arr + noff + i) T(std::move(arr[off + i]));
+        arr[off + i].~T();
+      }
+    }
+    off = noff;
+  }
+  inline void reallocate(size_type n, size_type noff) {
+    T *tarr = detail::allocate_buffer<T>(n);
+    detail::relocate(tarr + noff, arr + off, vec_sz);
+    detail::deallocate_buffer(arr, rsrv_sz);
+    arr = tarr;
+    rsrv_sz = n;
+    off = noff;
+  }
+  void allocate_and_copy(size_type count, const T *first) {
+    rsrv_sz = count << 2;
+    arr = detail::allocate_buffer<T>(rsrv_sz);
+    off = (rsrv_sz - count) / 2;
+    std::uninitialized_copy(first, first + count, arr + off);
+    vec_sz = count;
+  }
+
+  size_type rsrv_sz = 0, vec_sz = 0, off = 0;
+  T *arr = nullptr;
+};
+
+}  // namespace lni
+
+#endif  // CATZ_DEVECTOR
@@ -0,0 +1,337 @@
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "vector.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <unistd.h>
+#define CATZ_INCREMENTAL_RELEASE
+#endif
+
+#ifndef CATZ_INCREMENTAL_VECTOR
+#define CATZ_INCREMENTAL_VECTOR
+
+namespace lni {
+
+// Latency-bounded variant of lni::vector. Growth still allocates 4x the capacity, but instead of
+// relocating every element at once, the old buffer is drained MigrateChunk elements per following
+// push_back/emplace_back. While a migration is pending, indices in [migrated, old_sz) still live
+// in the old buffer and everything else in the new one, so no single push_back copies more than
+// MigrateChunk elements. data(), begin() and end() finish the pending migration first; the const
+// iterators read through operator[] instead. On POSIX, the pages of a large old buffer are handed
+// back to the OS as the migration passes them, so freeing it at the end does not stall either.
+template <typename T, size_t MigrateChunk = 64>
+class incremental_vector {
+  static_assert(MigrateChunk > 0, "MigrateChunk must be positive");
+
+ public:
+  // types:
+  typedef T value_type;
+  typedef T &reference;
+  typedef const T &const_reference;
+  typedef T *pointer;
+  typedef const T *const_pointer;
+  typedef T *iterator;
+  typedef ptrdiff_t difference_type;
+  typedef size_t size_type;
+
+  // reads through operator[], so it does not need the storage to be contiguous
+  class const_iterator {
+   public:
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef ptrdiff_t difference_type;
+    typedef const T *pointer;
+    typedef const T &reference;
+
+    const_iterator() noexcept = default;
+    const_iterator(const incremental_vector *o, size_type i) noexcept : owner(o), idx(i) {}
+
+    inline reference operator*() const noexcept { return (*owner)[idx]; }
+    inline pointer operator->() const noexcept { return &(*owner)[idx]; }
+    inline reference operator[](difference_type n) const noexcept { return (*owner)[idx + n]; }
+
+    inline const_iterator &operator++() noexcept {
+      ++idx;
+      return *this;
+    }
+    inline const_iterator operator++(int) noexcept { return const_iterator(owner, idx++); }
+    inline const_iterator &operator--() noexcept {
+      --idx;
+      return *this;
+    }
+    inline const_iterator operator--(int) noexcept { return const_iterator(owner, idx--); }
+    inline const_iterator &operator+=(difference_type n) noexcept {
+      idx += n;
+      return *this;
+    }
+    inline const_iterator &operator-=(difference_type n) noexcept {
+      idx -= n;
+      return *this;
+    }
+    inline const_iterator operator+(difference_type n) const noexcept {
+      return const_iterator(owner, idx + n);
+    }
+    inline const_iterator operator-(difference_type n) const noexcept {
+      return const_iterator(owner, idx - n);
+    }
+    friend inline const_iterator operator+(difference_type n, const const_iterator &it) noexcept {
+      return it + n;
+    }
+    inline difference_type operator-(const const_iterator &rhs) const noexcept {
+      return static_cast<difference_type>(idx) - static_cast<difference_type>(rhs.idx);
+    }
+    inline bool operator==(const const_iterator &rhs) const noexcept { return idx == rhs.idx; }
+    inline auto operator<=>(const const_iterator &rhs) const noexcept { return idx <=> rhs.idx; }
+
+   private:
+    const incremental_vector *owner = nullptr;
+    size_type idx = 0;
+  };
+
+  incremental_vector() noexcept {}
+
+  inline incremental_vector(const incremental_vector &other) {
+    rsrv_sz = other.vec_sz << 2;
+    arr = detail::allocate_buffer<T>(rsrv_sz);
+    for (; vec_sz < other.vec_sz; ++vec_sz) {
+      new (arr + vec_sz) T(other[vec_sz]);
+    }
+  }
+
+  inline incremental_vector(incremental_vector &&other) noexcept { swap(other); }
+
+  ~incremental_vector() {
+    clear();
+    detail::deallocate_buffer(arr, rsrv_sz);
+  }
+
+  inline incremental_vector &operator=(const incremental_vector &other) {
+    if (this != &other) {
+      incremental_vector tmp(other);
+      swap(tmp);
+    }
+    return *this;
+  }
+
+  inline incremental_vector &operator=(incremental_vector &&other) noexcept {
+    if (this != &other) {
+      incremental_vector tmp(std::move(other));
+      swap(tmp);
+    }
+    return *this;
+  }
+
+  inline iterator begin() {
+    finish_migration();
+    return arr;
+  }
+
+  inline iterator end() {
+    finish_migration();
+    return arr + vec_sz;
+  }
+
+  inline const_iterator begin() const noexcept { return const_iterator(this, 0); }
+
+  inline const_iterator cbegin() const noexcept { return const_iterator(this, 0); }
+
+  inline const_iterator end() const noexcept { return const_iterator(this, vec_sz); }
+
+  inline const_iterator cend() const noexcept { return const_iterator(this, vec_sz); }
+
+  inline T *data() {
+    finish_migration();
+    return arr;
+  }
+
+  inline bool empty() const noexcept { return vec_sz == 0; }
+
+  inline size_type size() const noexcept { return vec_sz; }
+
+  inline size_type capacity() const noexcept { return rsrv_sz; }
+
+  // true while elements are still being moved out of the previous buffer
+  inline bool migrating() const noexcept { return old_arr != nullptr; }
+
+  // reserve() is an explicit request, so it relocates everything synchronously
+  inline void reserve(size_type _sz) {
+    if (_sz > rsrv_sz) {
+      finish_migration();
+      T *tarr = detail::allocate_buffer<T>(_sz);
+      detail::relocate(tarr, arr, vec_sz);
+      detail::deallocate_buffer(arr, rsrv_sz);
+      arr = tarr;
+      rsrv_sz = _sz;
+    }
+  }
+
+  inline reference operator[](size_type idx) noexcept {
+    return (idx >= migrated && idx < old_sz) ? old_arr[idx] : arr[idx];
+  }
+
+  inline const_reference operator[](size_type idx) const noexcept {
+    return (idx >= migrated && idx < old_sz) ? old_arr[idx] : arr[idx];
+  }
+
+  inline reference at(size_type pos) {
+    return (pos < vec_sz) ? (*this)[pos]
+                          : throw std::out_of_range("accessed position is out of range");
+  }
+
+  inline const_reference at(size_type pos) const {
+    return (pos < vec_sz) ? (*this)[pos]
+                          : throw std::out_of_range("accessed position is out of range");
+  }
+
+  inline reference front() noexcept { return (*this)[0]; }
+
+  inline const_reference front() const noexcept { return (*this)[0]; }
+
+  inline reference back() noexcept { return (*this)[vec_sz - 1]; }
+
+  inline const_reference back() const noexcept { return (*this)[vec_sz - 1]; }
+
+  template <class... Args>
+  inline void emplace_back(Args &&...args) {
+    if (vec_sz == rsrv_sz) {
+      grow();
+    }
+    new (arr + vec_sz) T(std::forward<Args>(args)...);
+    ++vec_sz;
+    migrate_step();
+  }
+
+  inline void push_back(const T &val) { emplace_back(val); }
+
+  inline void push_back(T &&val) { emplace_back(std::move(val)); }
+
+  inline void pop_back() {
+    --vec_sz;
+    if (vec_sz >= migrated && vec_sz < old_sz) {
+      if constexpr (!std::is_trivially_destructible<T>::value) {
+        old_arr[vec_sz].~T();
+      }
+      old_sz = vec_sz;
+      if (migrated == old_sz) {
+        release_old();
+      }
+    } else if constexpr (!std::is_trivially_destructible<T>::value) {
+      arr[vec_sz].~T();
+    }
+  }
+
+  inline void swap(incremental_vector &rhs) noexcept {
+    std::swap(vec_sz, rhs.vec_sz);
+    std::swap(rsrv_sz, rhs.rsrv_sz);
+    std::swap(arr, rhs.arr);
+    std::swap(old_sz, rhs.old_sz);
+    std::swap(old_rsrv_sz, rhs.old_rsrv_sz);
+    std::swap(migrated, rhs.migrated);
+    std::swap(old_arr, rhs.old_arr);
+    std::swap(old_released, rhs.old_released);
+  }
+
+  inline void clear() noexcept {
+    if constexpr (!std::is_trivially_destructible<T>::value) {
+      std::destroy(arr, arr + migrated);
+      std::destroy(old_arr + migrated, old_arr + old_sz);
+      std::destroy(arr + (old_sz > migrated ? old_sz : migrated), arr + vec_sz);
+    }
+    release_old();
+    vec_sz = 0;
+  }
+
+  // moves whatever is left in the old buffer, making the storage contiguous again
+  inline void finish_migration() {
+    if (old_arr) {
+      detail::relocate(arr + migrated, old_arr + migrated, old_sz - migrated);
+      release_old();
+    }
+  }
+
+ private:
+  // the previous migration always completes before the new buffer fills up: it has at most
+  // rsrv_sz / 4 elements left and each of the following 3 * rsrv_sz / 4 insertions moves at
+  // least one of them
+  inline void grow() {
+    finish_migration();
+    size_type n = rsrv_sz ? rsrv_sz << 2 : 4;
+    old_arr = arr;
+    old_sz = vec_sz;
+    old_rsrv_sz = rsrv_sz;
+    migrated = 0;
+    arr = detail::allocate_buffer<T>(n);
+    rsrv_sz = n;
+#if defined(CATZ_INCREMENTAL_RELEASE) && defined(MADV_HUGEPAGE)
+    if (n * sizeof(T) >= release_min) {
+      advise(arr, arr + n, MADV_HUGEPAGE);
+    }
+#endif
+    if (!old_sz) {
+      release_old();
+    }
+  }
+  inline void migrate_step() {
+    if (old_arr) {
+      size_type cnt = old_sz - migrated < MigrateChunk ? old_sz - migrated : MigrateChunk;
+      detail::relocate(arr + migrated, old_arr + migrated, cnt);
+      migrated += cnt;
+      if (migrated == old_sz) {
+        release_old();
+      } else {
+        release_migrated();
+      }
+    }
+  }
+  // returns the whole pages below old_arr + migrated to the OS, 2MiB (one huge page) at a time;
+  // only for buffers too large for the buffer cache, which come straight from operator new
+  inline void release_migrated() noexcept {
+#ifdef CATZ_INCREMENTAL_RELEASE
+    if (old_rsrv_sz * sizeof(T) >= release_min &&
+        (migrated * sizeof(T) - old_released) >= release_step) {
+      char *base = reinterpret_cast<char *>(old_arr);
+      old_released = advise(base + old_released, old_arr + migrated, MADV_DONTNEED) - base;
+    }
+#endif
+  }
+#ifdef CATZ_INCREMENTAL_RELEASE
+  // madvise on the whole pages inside [first, last); returns where the advised range ends
+  static inline char *advise(void *first, void *last, int advice) noexcept {
+    static const uintptr_t page = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+    uintptr_t lo = (reinterpret_cast<uintptr_t>(first) + page - 1) & ~(page - 1);
+    uintptr_t hi = reinterpret_cast<uintptr_t>(last) & ~(page - 1);
+    if (hi <= lo) {
+      return static_cast<char *>(first);
+    }
+    madvise(reinterpret_cast<void *>(lo), hi - lo, advice);
+    return reinterpret_cast<char *>(hi);
+  }
+#endif
+  inline void release_old() noexcept {
+    detail::deallocate_buffer(old_arr, old_rsrv_sz);
+    old_arr = nullptr;
+    old_sz = old_rsrv_sz = migrated = old_released = 0;
+  }
+
+  static constexpr size_type release_min = size_type(4) << 20;
+  static constexpr size_type release_step = size_type(2) << 20;
+
+  size_type rsrv_sz = 0, vec_sz = 0;
+  T *arr = nullptr;
+  // pending migration: old_arr[migrated, old_sz) has not been moved to arr yet, and the pages
+  // below old_arr + old_released have already been given back
+  size_type old_sz = 0, old_rsrv_sz = 0, migrated = 0, old_released = 0;
+  T *old_arr = nullptr;
+};
+
+}  // namespace lni
+
+#endif  // CATZ_INCREMENTAL_VECTOR
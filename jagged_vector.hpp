@@ -0,0 +1,256 @@
+#include <compare>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "vector.hpp"
+
+#ifndef CATZ_JAGGED_VECTOR
+#define CATZ_JAGGED_VECTOR
+
+namespace lni {
+
+// Many variable-length rows packed CSR-style: all values in one lni::vector<T>, and row i spans
+// values[offsets[i], offsets[i + 1]). Both buffers grow like any lni::vector, so there is one
+// factor-4 slack per container instead of one allocation and one slack per row; compact() drops
+// that slack once the rows are built. Rows can only be added at, or appended to, the back.
+template <typename T>
+class jagged_vector {
+ public:
+  // types:
+  typedef T value_type;
+  typedef std::span<T> row_type;
+  typedef std::span<const T> const_row_type;
+  typedef ptrdiff_t difference_type;
+  typedef size_t size_type;
+
+  template <bool Const>
+  class row_iterator {
+   public:
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef std::conditional_t<Const, const_row_type, row_type> value_type;
+    typedef ptrdiff_t difference_type;
+    typedef void pointer;
+    typedef value_type reference;
+    typedef std::conditional_t<Const, const jagged_vector<T>, jagged_vector<T>> owner_type;
+
+    row_iterator() noexcept = default;
+    row_iterator(owner_type *o, size_type i) noexcept : owner(o), idx(i) {}
+
+    inline reference operator*() const noexcept { return owner->row(idx); }
+    inline reference operator[](difference_type n) const noexcept { return owner->row(idx + n); }
+
+    inline row_iterator &operator++() noexcept {
+      ++idx;
+      return *this;
+    }
+    inline row_iterator operator++(int) noexcept { return row_iterator(owner, idx++); }
+    inline row_iterator &operator--() noexcept {
+      --idx;
+      return *this;
+    }
+    inline row_iterator operator--(int) noexcept { return row_iterator(owner, idx--); }
+    inline row_iterator &operator+=(difference_type n) noexcept {
+      idx += n;
+      return *this;
+    }
+    inline row_iterator &operator-=(difference_type n) noexcept {
+      idx -= n;
+      return *this;
+    }
+    inline row_iterator operator+(difference_type n) const noexcept {
+      return row_iterator(owner, idx + n);
+    }
+    inline row_iterator operator-(difference_type n) const noexcept {
+      return row_iterator(owner, idx - n);
+    }
+    inline difference_type operator-(const row_iterator &rhs) const noexcept {
+      return static_cast<difference_type>(idx) - static_cast<difference_type>(rhs.idx);
+    }
+    inline bool operator==(const row_iterator &rhs) const noexcept { return idx == rhs.idx; }
+    inline auto operator<=>(const row_iterator &rhs) const noexcept { return idx <=> rhs.idx; }
+
+   private:
+    owner_type *owner = nullptr;
+    size_type idx = 0;
+  };
+
+  typedef row_iterator<false> iterator;
+  typedef row_iterator<true> const_iterator;
+
+  jagged_vector() noexcept {}
+
+  inline iterator begin() noexcept { return iterator(this, 0); }
+
+  inline const_iterator begin() const noexcept { return const_iterator(this, 0); }
+
+  inline iterator end() noexcept { return iterator(this, size()); }
+
+  inline const_iterator end() const noexcept { return const_iterator(this, size()); }
+
+  inline bool empty() const noexcept { return size() == 0; }
+
+  // number of rows
+  inline size_type size() const noexcept { return offsets.empty() ? 0 : offsets.size() - 1; }
+
+  // number of values over all rows
+  inline size_type num_values() const noexcept { return values.size(); }
+
+  inline size_type row_size(size_type idx) const noexcept {
+    return offsets[idx + 1] - offsets[idx];
+  }
+
+  inline void reserve(size_type rows, size_type vals) {
+    offsets.reserve(rows + 1);
+    values.reserve(vals);
+  }
+
+  inline row_type row(size_type idx) noexcept {
+    return row_type(values.data() + offsets[idx], offsets[idx + 1] - offsets[idx]);
+  }
+
+  inline const_row_type row(size_type idx) const noexcept {
+    return const_row_type(values.data() + offsets[idx], offsets[idx + 1] - offsets[idx]);
+  }
+
+  inline row_type operator[](size_type idx) noexcept { return row(idx); }
+
+  inline const_row_type operator[](size_type idx) const noexcept { return row(idx); }
+
+  inline row_type at(size_type pos) {
+    return (pos < size()) ? row(pos) : throw std::out_of_range("accessed row is out of range");
+  }
+
+  inline const_row_type at(size_type pos) const {
+    return (pos < size()) ? row(pos) : throw std::out_of_range("accessed row is out of range");
+  }
+
+  inline row_type back() noexcept { return row(size() - 1); }
+
+  inline const_row_type back() const noexcept { return row(size() - 1); }
+
+  // the underlying buffers, e.g. for bulk scans or serialization
+  inline const vector<T> &data() const noexcept { return values; }
+
+  inline const vector<size_type> &row_offsets() const noexcept { return offsets; }
+
+  // adds an empty row, to be filled with append()
+  inline void push_row() {
+    if (offsets.empty()) {
+      offsets.push_back(0);
+    }
+    offsets.push_back(values.size());
+  }
+
+  template <typename Range>
+  inline void push_row(const Range &r) {
+    push_row();
+    append_range(r);
+  }
+
+  inline void push_row(std::initializer_list<T> lst) {
+    push_row();
+    values.insert(values.end(), lst);
+    offsets.back() = values.size();
+  }
+
+  inline void pop_row() {
+    values.resize(offsets[offsets.size() - 2]);
+    offsets.pop_back();
+  }
+
+  // appends to the last row; args may refer into this container, so when values is full the
+  // element is built before values reallocates
+  template <class... Args>
+  inline void emplace_back(Args &&...args) {
+    if (values.size() == values.capacity()) {
+      T tmp(std::forward<Args>(args)...);
+      values.emplace_back(std::move(tmp));
+    } else {
+      values.emplace_back(std::forward<Args>(args)...);
+    }
+    ++offsets.back();
+  }
+
+  inline void append(const T &val) { emplace_back(val); }
+
+  inline void append(T &&val) { emplace_back(std::move(val)); }
+
+  // r may be a row of this container: a contiguous r is re-read from values after any growth;
+  // anything else is copied straight into the spare capacity, and only what does not fit is
+  // staged in a temporary before values reallocates
+  template <typename Range>
+  inline void append_range(const Range &r) {
+    if constexpr (std::ranges::contiguous_range<const Range> &&
+                  std::ranges::sized_range<const Range> &&
+                  std::is_same_v<std::ranges::range_value_t<const Range>, T>) {
+      const T *first = std::ranges::data(r);
+      size_type n = std::ranges::size(r);
+      if (values.size() + n > values.capacity()) {
+        std::less<const T *> lt;
+        bool inside = !lt(first, values.data()) && lt(first, values.data() + values.size());
+        size_type off = inside ? static_cast<size_type>(first - values.data()) : 0;
+        values.reserve((values.size() + n) << 2);
+        if (inside) {
+          first = values.data() + off;
+        }
+      }
+      values.insert(values.end(), first, first + n);
+    } else {
+      auto it = std::ranges::begin(r);
+      auto last = std::ranges::end(r);
+      size_type copied = 0;
+      for (; it != last && values.size() < values.capacity(); ++it, ++copied) {
+        values.push_back(*it);
+      }
+      if (it != last) {
+        vector<T> tmp;
+        if constexpr (std::ranges::sized_range<const Range>) {
+          tmp.reserve(static_cast<size_type>(std::ranges::size(r)) - copied);
+        }
+        for (; it != last; ++it) {
+          tmp.push_back(*it);
+        }
+        values.insert(
+            values.end(), std::make_move_iterator(tmp.begin()), std::make_move_iterator(tmp.end()));
+      }
+    }
+    offsets.back() = values.size();
+  }
+
+  // releases the growth slack of both buffers, e.g. once all rows have been loaded
+  inline void compact() {
+    values.shrink_to_fit();
+    offsets.shrink_to_fit();
+  }
+
+  // heap bytes held by both buffers, slack included
+  inline size_type memory_usage() const noexcept {
+    return values.capacity() * sizeof(T) + offsets.capacity() * sizeof(size_type);
+  }
+
+  inline void clear() noexcept {
+    values.clear();
+    offsets.clear();
+  }
+
+  inline void swap(jagged_vector<T> &rhs) noexcept {
+    values.swap(rhs.values);
+    offsets.swap(rhs.offsets);
+  }
+
+ private:
+  vector<T> values;
+  // offsets[0] == 0 is only pushed with the first row, so an unused container never allocates
+  vector<size_type> offsets;
+};
+
+}  // namespace lni
+
+#endif  // CATZ_JAGGED_VECTOR
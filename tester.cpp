@@ -1,11 +1,23 @@
+#include <cstdio>
 #include <ctime>
 #include <iomanip>
 #include <iostream>
+#include <list>
+#include <ranges>
 #include <utility>
 #include <vector>
 
+#include "bit_vector.hpp"
+#include "capacity_hints.hpp"
+#include "devector.hpp"
+#include "incremental_vector.hpp"
+#include "jagged_vector.hpp"
 #include "vector.hpp"
 
+#ifdef CATZ_VECTOR_FD_IO
+#include <fcntl.h>
+#endif
+
 class test {
  public:
   int a, b, c;
@@ -32,6 +44,15 @@ int main() {
 
   std::cout << "max_size(): " << v1.max_size() << "\n\n";
 
+  std::cout << "Testing default construction and move ...\n";
+  lni::vector<int> v0;
+  std::cout << " default capacity: " << v0.capacity() << "\n";
+  v0.push_back(1);
+  const int *v0_data = v0.data();
+  lni::vector<int> v0_moved(std::move(v0));
+  std::cout << " buffer stolen: " << (v0_moved.data() == v0_data) << ", source capacity: "
+            << v0.capacity() << "\n\n";
+
   std::cout << "Testing emplace and emplace_back ...\n";
   lni::vector<test> vt;
   vt.push_back(test(1, 2, 3));
@@ -221,6 +242,186 @@ int main() {
   lni::Print(v9, "v9");
   for (auto &n : v9) std::cout << " " << n;
   std::cout << std::endl;
+
+  std::cout << "\nTesting bit_vector ... " << std::endl;
+  lni::bit_vector vb(130);
+  vb[0] = true;
+  vb[64] = true;
+  vb[129] = true;
+  vb.push_back(true);
+  std::cout << " size: " << vb.size() << ", capacity: " << vb.capacity()
+            << ", count: " << vb.count() << std::endl;
+  std::cout << " set bits:";
+  for (auto pos = vb.find_first(); pos != lni::bit_vector::npos; pos = vb.find_next(pos))
+    std::cout << " " << pos;
+  std::cout << std::endl;
+  lni::bit_vector vb2(131, true);
+  vb2[64] = false;
+  vb2 &= vb;
+  std::cout << " and count: " << vb2.count() << std::endl;
+  vb2 |= vb;
+  std::cout << " or count: " << vb2.count() << std::endl;
+  vb2 ^= lni::bit_vector(131, true);
+  std::cout << " xor count: " << vb2.count() << std::endl;
+  vb2.flip();
+  std::cout << " vb2 == vb: " << (vb2 == vb) << std::endl;
+  vb.resize(3);
+  vb.pop_back();
+  std::cout << " after resize(3), pop_back():";
+  for (bool b : vb) std::cout << " " << b;
+  std::cout << ", count: " << vb.count() << std::endl;
+
+  lni::vector<bool> vbb(4, false);
+  vbb.insert(vbb.begin() + 1, true);
+  vbb.erase(vbb.begin());
+  std::cout << " vector<bool> after insert/erase:";
+  for (bool b : vbb) std::cout << " " << b;
+  std::cout << ", < " << (vbb < lni::vector<bool>(4, true)) << std::endl;
+
+  std::cout << "\nTesting incremental_vector ... " << std::endl;
+  lni::incremental_vector<int, 2> vi;
+  for (i = 0; i < 20; ++i) vi.push_back(i);
+  std::cout << " size: " << vi.size() << ", capacity: " << vi.capacity()
+            << ", migrating: " << vi.migrating() << std::endl;
+  vi[17] = -17;
+  vi.pop_back();
+  std::cout << " indexed:";
+  for (size_t j = 0; j < vi.size(); ++j) std::cout << " " << vi[j];
+  std::cout << std::endl;
+  const lni::incremental_vector<int, 2> &cvi = vi;
+  std::cout << " const iterated:";
+  for (const auto &n : cvi) std::cout << " " << n;
+  std::cout << ", migrating: " << vi.migrating() << std::endl;
+  std::cout << " iterated:";
+  for (auto &n : vi) std::cout << " " << n;
+  std::cout << ", migrating: " << vi.migrating() << std::endl;
+
+  std::cout << "\nTesting devector ... " << std::endl;
+  lni::devector<int> vd;
+  for (i = 0; i < 5; ++i) {
+    vd.push_back(i);
+    vd.push_front(-i);
+  }
+  vd.emplace_front(-10);
+  vd.pop_back();
+  vd.pop_front();
+  std::cout << " size: " << vd.size() << ", capacity: " << vd.capacity()
+            << ", front_free: " << vd.front_free() << ", back_free: " << vd.back_free()
+            << std::endl;
+  std::cout << " contents:";
+  for (const auto &n : vd) std::cout << " " << n;
+  std::cout << std::endl;
+  lni::devector<std::string> vdr = {"item-0", "item-1", "item-2", "item-3"};
+  for (i = 0; i < 21; ++i) {  // walks off the back, so push_back has to recenter
+    vdr.push_back(vdr.front());
+    vdr.pop_front();
+  }
+  lni::devector<std::string> vdg;
+  for (i = 0; i < 4; ++i) vdg.push_back("item-" + std::to_string(i));
+  vdg.push_front(vdg.back());  // full, so push_front has to grow
+  vdg.pop_back();
+  vdg.push_back(vdg.front());  // the growth only made room in front
+  vdg.pop_front();
+  std::cout << " rotated:";
+  for (const auto &str : vdr) std::cout << " [" << str << "]";
+  std::cout << ", grown:";
+  for (const auto &str : vdg) std::cout << " [" << str << "]";
+  std::cout << std::endl;
+
+  std::cout << "\nTesting capacity hints ... " << std::endl;
+  for (int round = 0; round < 2; ++round) {
+    for (int k = 0; k < 20; ++k) {
+      lni::hinted_vector<int> vh;
+      std::cout << (k == 0 ? " first capacity of the round: " : "");
+      if (k == 0) std::cout << vh.capacity() << std::endl;
+      for (i = 0; i < 90 + k; ++i) vh.push_back(i);
+    }
+  }
+
+  std::cout << "\nTesting jagged_vector ... " << std::endl;
+  lni::jagged_vector<int> vj;
+  vj.push_row({1, 2, 3});
+  vj.push_row();
+  vj.push_row(v2);
+  vj.append(99);
+  std::vector<int> std_row{7, 8};
+  vj.push_row(std_row);
+  vj.pop_row();
+  vj.compact();
+  std::cout << " rows: " << vj.size() << ", values: " << vj.num_values()
+            << ", bytes: " << vj.memory_usage() << std::endl;
+  vj.push_row(vj.row(0));
+  vj.push_row(vj.row(2) | std::views::reverse);
+  vj.compact();
+  vj.append(vj.row(0)[0]);
+  std::list<int> lst_row{5, 6};
+  vj.push_row(lst_row);
+  for (auto row : vj) {
+    std::cout << " [";
+    for (const auto &n : row) std::cout << " " << n;
+    std::cout << " ]";
+  }
+  std::cout << std::endl;
+
+  std::cout << "\nTesting sort, stable_sort and radix_sort ... " << std::endl;
+  lni::vector<int> vs1 = {5, -3, 9, 0, -3, 42, 7, -100};
+  lni::vector<int> vs2(vs1), vs3(vs1);
+  vs1.sort();
+  vs2.stable_sort(std::greater<int>(), 2);
+  vs3.radix_sort();
+  std::cout << " sort:";
+  for (const auto &n : vs1) std::cout << " " << n;
+  std::cout << "\n stable_sort(greater):";
+  for (const auto &n : vs2) std::cout << " " << n;
+  std::cout << "\n radix_sort:";
+  for (const auto &n : vs3) std::cout << " " << n;
+  std::cout << std::endl;
+  lni::vector<double> vs4 = {2.5, -0.5, 1e9, -7.25, 0.0};
+  vs4.radix_sort();
+  std::cout << " radix_sort(double):";
+  for (const auto &f : vs4) std::cout << " " << f;
+  std::cout << std::endl;
+
+#ifdef CATZ_VECTOR_FD_IO
+  std::cout << "\nTesting append_from_fd and read_into ... " << std::endl;
+  FILE *tf = tmpfile();
+  int raw[6] = {1, 2, 3, 4, 5, 6};
+  fwrite(raw, sizeof(int), 6, tf);
+  fwrite("xy", 1, 2, tf);
+  fflush(tf);
+  rewind(tf);
+  lni::vector<int> vf{0};
+  std::cout << " append_from_fd(fd, 10): " << vf.append_from_fd(fileno(tf), 10) << " bytes";
+  std::cout << ", pread at 16: " << vf.append_from_fd(fileno(tf), 8, 16) << " bytes";
+  std::cout << ", read_into: " << vf.read_into(fileno(tf)) << " bytes" << std::endl;
+  for (const auto &n : vf) std::cout << " " << n;
+  std::cout << std::endl;
+  rewind(tf);
+  lni::vector<char> vfc;
+  std::cout << " append_from_fd(fd, 1 << 28): " << vfc.append_from_fd(fileno(tf), 1 << 28)
+            << " bytes, capacity: " << vfc.capacity() << std::endl;
+  rewind(tf);
+  lni::vector<int> vfi;
+  std::cout << " append_from_fd(fd, 1 << 62): "
+            << vfi.append_from_fd(fileno(tf), size_t(1) << 62)
+            << " bytes, capacity: " << vfi.capacity() << std::endl;
+  fclose(tf);
+  int pfd[2];
+  if (pipe(pfd) == 0) {
+    fcntl(pfd[0], F_SETFL, fcntl(pfd[0], F_GETFL) | O_NONBLOCK);
+    int ten[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    if (write(pfd[1], ten, sizeof(ten)) == static_cast<ssize_t>(sizeof(ten))) {
+      lni::vector<int> vp;
+      std::cout << " non-blocking pipe, append_from_fd(fd, 1000): "
+                << vp.append_from_fd(pfd[0], 1000) << " bytes, then "
+                << vp.append_from_fd(pfd[0], 1000) << " bytes:";
+      for (const auto &n : vp) std::cout << " " << n;
+      std::cout << std::endl;
+    }
+    close(pfd[0]);
+    close(pfd[1]);
+  }
+#endif
 #endif
 
   st = clock();
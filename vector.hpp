@@ -1,17 +1,285 @@
+#include <algorithm>
+#include <bit>
+#include <compare>
 #include <cstddef>
+#include <cstdint>
 #include <cstring>
+#include <functional>
 #include <iostream>
 #include <iterator>
+#include <limits>
+#include <memory>
 #include <stdexcept>
 #include <string>
+#include <thread>
+#include <type_traits>
 #include <utility>
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <system_error>
+#define CATZ_VECTOR_FD_IO
+#endif
+
 #ifndef CATZ_VECTOR
 #define CATZ_VECTOR
 #define CATZ_VECTOR_MAX_SZ std::numeric_limits<size_type>::max() / sizeof(T)
 
 namespace lni {
 
+#ifdef CATZ_VECTOR_BUFFER_CACHE
+namespace detail {
+
+// Per-thread free lists of vector buffers, one per factor-4 size class (64B, 256B, ..., 1MiB).
+// Cached buffers are allocated at their full class size, so any buffer filed under a class fits
+// any request rounded up to that class. Larger requests go straight to operator new unrounded,
+// which bounds what a thread can hold to about 5.3MiB. Define CATZ_VECTOR_BUFFER_CACHE for the
+// whole program.
+class buffer_cache {
+ public:
+  static constexpr size_t min_bytes = 64;
+  static constexpr size_t num_classes = 8;  // largest cached class is 1MiB
+  static constexpr size_t per_class = 4;
+
+  ~buffer_cache() {
+    for (size_t c = 0; c < num_classes; ++c) {
+      while (cnt[c]) {
+        operator delete(slots[c][--cnt[c]]);
+      }
+    }
+    gone() = true;
+  }
+
+  // rounds bytes up to its size class if that class is cached, and returns a buffer at least
+  // that large
+  static inline void *allocate(size_t &bytes) {
+    size_t c = class_of(bytes);
+    if (c < num_classes) {
+      bytes = min_bytes << (2 * c);
+      buffer_cache *cache = local();
+      if (cache && cache->cnt[c]) {
+        return cache->slots[c][--cache->cnt[c]];
+      }
+    }
+    return operator new(bytes);
+  }
+
+  // bytes may be less than the size the buffer was allocated with, never more
+  static inline void deallocate(void *p, size_t bytes) noexcept {
+    size_t c = class_of(bytes);
+    buffer_cache *cache = local();
+    if (c < num_classes && cache && cache->cnt[c] < per_class) {
+      cache->slots[c][cache->cnt[c]++] = p;
+    } else {
+      operator delete(p);
+    }
+  }
+
+ private:
+  // smallest class whose size is >= bytes
+  static inline size_t class_of(size_t bytes) noexcept {
+    if (bytes <= min_bytes) {
+      return 0;
+    }
+    return (static_cast<size_t>(std::bit_width(bytes - 1)) - 5) / 2;
+  }
+  // trivially destructible flag, still readable after the cache itself is gone at thread exit
+  static inline bool &gone() noexcept {
+    thread_local bool flag = false;
+    return flag;
+  }
+  static inline buffer_cache *local() noexcept {
+    if (gone()) {
+      return nullptr;
+    }
+    thread_local buffer_cache cache;
+    return &cache;
+  }
+
+  void *slots[num_classes][per_class];
+  size_t cnt[num_classes] = {};
+};
+
+}  // namespace detail
+#endif
+
+namespace detail {
+
+// Raw storage for n elements; n may be rounded up to the size class of the buffer cache.
+template <typename T>
+inline T *allocate_buffer(size_t &n) {
+  if (n == 0) {
+    return nullptr;
+  }
+#ifdef CATZ_VECTOR_BUFFER_CACHE
+  size_t bytes = n * sizeof(T);
+  void *p = buffer_cache::allocate(bytes);
+  n = bytes / sizeof(T);
+  return static_cast<T *>(p);
+#else
+  return static_cast<T *>(operator new(n * sizeof(T)));
+#endif
+}
+
+template <typename T>
+inline void deallocate_buffer(T *p, size_t n) noexcept {
+  if (!p) {
+    return;
+  }
+#ifdef CATZ_VECTOR_BUFFER_CACHE
+  buffer_cache::deallocate(p, n * sizeof(T));
+#else
+  (void)n;
+  operator delete(p);
+#endif
+}
+
+// Moves n elements from src into uninitialized dst and ends their lifetime in src.
+template <typename T>
+inline void relocate(T *dst, T *src, size_t n) {
+  if constexpr (std::is_trivially_copyable<T>::value) {
+    if (n) {
+      memcpy(dst, src, n * sizeof(T));
+    }
+  } else {
+    std::uninitialized_move(src, src + n, dst);
+    std::destroy(src, src + n);
+  }
+}
+
+// below this many elements the threaded sorts run single-threaded
+constexpr size_t parallel_sort_min = size_t(1) << 16;
+
+// runs f(i) for every i in [0, tasks) on up to `threads` threads, the caller's included
+template <typename F>
+inline void parallel_for(unsigned threads, size_t tasks, F &&f) {
+  size_t workers = std::min<size_t>(threads ? threads : 1, tasks);
+  auto work = [&](size_t w) {
+    for (size_t i = w; i < tasks; i += workers) {
+      f(i);
+    }
+  };
+  if (workers <= 1) {
+    work(0);
+    return;
+  }
+  std::unique_ptr<std::thread[]> pool(new std::thread[workers - 1]);
+  for (size_t w = 1; w < workers; ++w) {
+    pool[w - 1] = std::thread(work, w);
+  }
+  work(0);
+  for (size_t w = 1; w < workers; ++w) {
+    pool[w - 1].join();
+  }
+}
+
+// Merges the sorted runs a[k * run, (k + 1) * run) pairwise, ping-ponging between a and the
+// scratch s, until a[0, n) is sorted. Merges of one level run in parallel.
+template <typename T, class Compare>
+inline void merge_runs(T *a, T *s, size_t n, size_t run, unsigned threads, Compare comp) {
+  T *src = a, *dst = s;
+  for (size_t w = run; w < n; w <<= 1) {
+    parallel_for(threads, (n + 2 * w - 1) / (2 * w), [&](size_t p) {
+      size_t lo = p * 2 * w, mid = std::min(lo + w, n), hi = std::min(lo + 2 * w, n);
+      std::merge(src + lo, src + mid, src + mid, src + hi, dst + lo, comp);
+    });
+    std::swap(src, dst);
+  }
+  if (src != a) {
+    memcpy(a, src, n * sizeof(T));
+  }
+}
+
+// stable bottom-up merge sort of a[0, n) with s[0, n) as scratch, for trivially copyable T
+template <typename T, class Compare>
+inline void merge_sort(T *a, T *s, size_t n, Compare comp) {
+  const size_t run = 32;
+  for (size_t lo = 0; lo < n; lo += run) {
+    size_t hi = std::min(lo + run, n);
+    for (size_t i = lo + 1; i < hi; ++i) {
+      T v = a[i];
+      size_t j = i;
+      for (; j > lo && comp(v, a[j - 1]); --j) {
+        a[j] = a[j - 1];
+      }
+      a[j] = v;
+    }
+  }
+  merge_runs(a, s, n, run, 1, comp);
+}
+
+// maps an arithmetic value to an unsigned key with the same ordering
+template <typename T>
+inline auto radix_key(T v) noexcept {
+  static_assert(sizeof(T) <= 8, "radix_sort supports keys of up to 64 bits");
+  typedef std::conditional_t<
+      sizeof(T) == 1,
+      uint8_t,
+      std::conditional_t<sizeof(T) == 2,
+                         uint16_t,
+                         std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>>>
+      U;
+  constexpr U top = static_cast<U>(U(1) << (sizeof(T) * 8 - 1));
+  if constexpr (std::is_floating_point<T>::value) {
+    U u = std::bit_cast<U>(v);
+    return static_cast<U>((u & top) ? ~u : u | top);
+  } else if constexpr (std::is_signed<T>::value) {
+    return static_cast<U>(static_cast<U>(v) ^ top);
+  } else {
+    return static_cast<U>(v);
+  }
+}
+
+// LSD radix sort on 8-bit digits with s[0, n) as scratch. Each worker histograms and scatters
+// its own chunk; chunk-ordered offsets keep the sort stable. Passes whose digit is the same for
+// every element are skipped.
+template <typename T>
+inline void radix_sort(T *a, T *s, size_t n, unsigned threads) {
+  size_t workers = (threads > 1 && n >= parallel_sort_min) ? threads : 1;
+  size_t chunk = (n + workers - 1) / workers;
+  std::unique_ptr<size_t[]> cnt(new size_t[workers * 256]);
+  T *src = a, *dst = s;
+  for (unsigned shift = 0; shift < sizeof(T) * 8; shift += 8) {
+    parallel_for(workers, workers, [&](size_t w) {
+      size_t *c = &cnt[w * 256];
+      std::fill(c, c + 256, size_t(0));
+      for (size_t i = w * chunk, hi = std::min(n, i + chunk); i < hi; ++i) {
+        ++c[(radix_key(src[i]) >> shift) & 255];
+      }
+    });
+    size_t sum = 0;
+    bool skip = false;
+    for (size_t d = 0; d < 256; ++d) {
+      size_t digit_total = 0;
+      for (size_t w = 0; w < workers; ++w) {
+        size_t c = cnt[w * 256 + d];
+        cnt[w * 256 + d] = sum;
+        sum += c;
+        digit_total += c;
+      }
+      skip |= digit_total == n;
+    }
+    if (skip) {
+      continue;
+    }
+    parallel_for(workers, workers, [&](size_t w) {
+      size_t *o = &cnt[w * 256];
+      for (size_t i = w * chunk, hi = std::min(n, i + chunk); i < hi; ++i) {
+        dst[o[(radix_key(src[i]) >> shift) & 255]++] = src[i];
+      }
+    });
+    std::swap(src, dst);
+  }
+  if (src != a) {
+    memcpy(a, src, n * sizeof(T));
+  }
+}
+
+}  // namespace detail
+
 template <typename T>
 class vector {
  public:
@@ -27,18 +295,19 @@ class vector {
   typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
   typedef ptrdiff_t difference_type;
   typedef size_t size_type;
-  vector() noexcept { arr = new T[rsrv_sz]; }
+  // no allocation until the first insertion
+  vector() noexcept {}
 
   inline vector(typename vector<T>::size_type n) {
     rsrv_sz = n << 2;
-    arr = static_cast<T *>(operator new[](rsrv_sz * sizeof(T)));
+    arr = detail::allocate_buffer<T>(rsrv_sz);
     std::uninitialized_default_construct_n(arr, n);
     vec_sz = n;
   }
 
   inline vector(typename vector<T>::size_type n, const T &value) {
     rsrv_sz = n << 2;
-    arr = static_cast<T *>(operator new[](rsrv_sz * sizeof(T)));
+    arr = detail::allocate_buffer<T>(rsrv_sz);
     std::uninitialized_fill_n(arr, n, value);
     vec_sz = n;
   }
@@ -58,67 +327,60 @@ class vector {
     allocate_and_copy(count, other.arr);
   }
 
-  inline vector(vector<T> &&other) noexcept {
-    rsrv_sz = other.rsrv_sz;
-    vec_sz = other.vec_sz;
-    arr = static_cast<T *>(operator new[](rsrv_sz * sizeof(T)));
-    std::uninitialized_move(other.arr, other.arr + vec_sz, arr);
-    other.vec_sz = 0;
-    other.arr = nullptr;
-    other.rsrv_sz = 0;
-  }
+  // steals other's buffer; other is left empty without a buffer
+  inline vector(vector<T> &&other) noexcept { swap(other); }
 
   ~vector() {
-    if (arr) {
-      delete[] arr;
-    }
+    clear();
+    detail::deallocate_buffer(arr, rsrv_sz);
   }
 
   inline vector<T> &operator=(const vector<T> &other) {
     if (this != &other) {
+      clear();
       ensure_capacity(other.vec_sz);
-      std::copy(other.arr, other.arr + other.vec_sz, arr);
+      std::uninitialized_copy(other.arr, other.arr + other.vec_sz, arr);
       vec_sz = other.vec_sz;
     }
     return *this;
   }
 
-  inline vector<T> &operator=(vector<T> &&other) {
+  inline vector<T> &operator=(vector<T> &&other) noexcept {
     if (this != &other) {
-      ensure_capacity(other.vec_sz);
-      std::move(other.arr, other.arr + other.vec_sz, arr);
-      vec_sz = other.vec_sz;
-      other.vec_sz = 0;
-      other.arr = nullptr;
-      other.rsrv_sz = 0;
+      vector<T> tmp(std::move(other));
+      swap(tmp);
     }
     return *this;
   }
 
   inline vector<T> &operator=(std::initializer_list<T> lst) {
+    clear();
     ensure_capacity(lst.size());
-    std::copy(lst.begin(), lst.end(), arr);
+    std::uninitialized_copy(lst.begin(), lst.end(), arr);
     vec_sz = static_cast<size_type>(lst.size());
     return *this;
   }
 
   inline void assign(typename vector<T>::size_type count, const T &value) {
+    clear();
     ensure_capacity(count);
-    std::fill(arr, arr + count, value);
+    std::uninitialized_fill_n(arr, count, value);
     vec_sz = count;
   }
 
   inline void assign(typename vector<T>::iterator first, typename vector<T>::iterator last) {
     size_type count = static_cast<size_type>(last - first);
+    clear();
     ensure_capacity(count);
-    std::copy(first, last, arr);
+    std::uninitialized_copy(first, last, arr);
     vec_sz = count;
   }
 
   inline void assign(std::initializer_list<T> lst) {
     size_type count = static_cast<size_type>(lst.size());
+    clear();
     ensure_capacity(count);
-    std::copy(lst.begin(), lst.end(), arr);
+    std::uninitialized_copy(lst.begin(), lst.end(), arr);
     vec_sz = count;
   }
 
@@ -158,15 +420,13 @@ class vector {
 
   inline void reserve(typename vector<T>::size_type _sz) {
     if (_sz > rsrv_sz) {
-      rsrv_sz = _sz;
-      reallocate();
+      reallocate(_sz);
     }
   }
 
   inline void shrink_to_fit() {
     if (rsrv_sz != vec_sz) {
-      rsrv_sz = vec_sz;
-      reallocate();
+      reallocate(vec_sz);
     }
   }
 
@@ -201,28 +461,25 @@ class vector {
   template <class... Args>
   inline void emplace_back(Args &&...args) {
     if (vec_sz == rsrv_sz) {
-      rsrv_sz <<= 2;
-      reallocate();
+      grow();
     }
-    arr[vec_sz] = std::move(T(std::forward<Args>(args)...));
+    new (arr + vec_sz) T(std::forward<Args>(args)...);
     ++vec_sz;
   }
 
   inline void push_back(const T &val) {
     if (vec_sz == rsrv_sz) {
-      rsrv_sz <<= 2;
-      reallocate();
+      grow();
     }
-    arr[vec_sz] = val;
+    new (arr + vec_sz) T(val);
     ++vec_sz;
   }
 
   inline void push_back(T &&val) {
     if (vec_sz == rsrv_sz) {
-      rsrv_sz <<= 2;
-      reallocate();
+      grow();
     }
-    arr[vec_sz] = std::move(val);
+    new (arr + vec_sz) T(std::move(val));
     ++vec_sz;
   }
 
@@ -236,35 +493,33 @@ class vector {
   template <class... Args>
   inline typename vector<T>::iterator emplace(
       typename vector<T>::const_iterator it, Args &&...args) {
-    iterator iit = &arr[it - arr];
+    size_type idx = static_cast<size_type>(it - arr);
     if (vec_sz == rsrv_sz) {
-      rsrv_sz <<= 2;
-      reallocate();
+      grow();
     }
-    memmove(iit + 1, iit, (vec_sz - (it - arr)) * sizeof(T));
-    (*iit) = std::move(T(std::forward<Args>(args)...));
+    iterator iit = arr + idx;
+    memmove(iit + 1, iit, (vec_sz - idx) * sizeof(T));
+    new (iit) T(std::forward<Args>(args)...);
     ++vec_sz;
     return iit;
   }
 
   inline typename vector<T>::iterator insert(typename vector<T>::const_iterator it, const T &val) {
-    iterator f = insert_impl(it, 1);  
-    (*f) = val;
+    iterator f = insert_impl(it, 1);
+    new (f) T(val);
     return f;
   }
 
   inline typename vector<T>::iterator insert(typename vector<T>::const_iterator it, T &&val) {
-    iterator f = insert_impl(it, 1);  
-    (*f) = std::move(val);
+    iterator f = insert_impl(it, 1);
+    new (f) T(std::move(val));
     return f;
   }
 
   inline typename vector<T>::iterator insert(
       typename vector<T>::const_iterator it, size_type cnt, const T &val) {
-    iterator f = insert_impl(it, cnt);  
-    for (iterator cur = f; cnt--; ++cur) {
-      (*cur) = val;
-    }
+    iterator f = insert_impl(it, cnt);
+    std::uninitialized_fill_n(f, cnt, val);
     return f;
   }
 
@@ -272,22 +527,16 @@ class vector {
   inline typename vector<T>::iterator insert(
       typename vector<T>::const_iterator it, InputIt first, InputIt last) {
     size_type cnt = static_cast<size_type>(last - first);
-    iterator f = insert_impl(it, cnt);  
-    for (iterator cur = f; first != last; ++cur, ++first) {
-      (*cur) = *first;
-    }
+    iterator f = insert_impl(it, cnt);
+    std::uninitialized_copy(first, last, f);
     return f;
   }
 
   inline typename vector<T>::iterator insert(
       typename vector<T>::const_iterator it, std::initializer_list<T> lst) {
     size_type cnt = lst.size();
-    iterator f = insert_impl(it, cnt);  
-    iterator iit = f;
-    for (auto &item : lst) {
-      (*iit) = item;
-      ++iit;
-    }
+    iterator f = insert_impl(it, cnt);
+    std::uninitialized_copy(lst.begin(), lst.end(), f);
     return f;
   }
 
@@ -333,15 +582,177 @@ class vector {
 
   inline void resize(typename vector<T>::size_type sz, const T &c) { resize_impl(sz, &c); }
 
+  // The sorts below use the spare capacity past end() as scratch space, reserving 2 * size()
+  // once if there is not enough of it. With threads > 1, chunks are sorted in parallel and then
+  // merged through the scratch. T that is not trivially copyable falls back to std::sort and
+  // std::stable_sort.
+  template <class Compare = std::less<T>>
+  inline void sort(Compare comp = Compare(), unsigned threads = 1) {
+    if constexpr (std::is_trivially_copyable<T>::value) {
+      if (threads > 1 && vec_sz >= detail::parallel_sort_min) {
+        T *s = sort_scratch();
+        size_type chunk = (vec_sz + threads - 1) / threads;
+        detail::parallel_for(threads, threads, [&](size_t t) {
+          size_type lo = std::min(t * chunk, vec_sz), hi = std::min(lo + chunk, vec_sz);
+          std::sort(arr + lo, arr + hi, comp);
+        });
+        detail::merge_runs(arr, s, vec_sz, chunk, threads, comp);
+        return;
+      }
+    }
+    std::sort(arr, arr + vec_sz, comp);
+  }
+
+  template <class Compare = std::less<T>>
+  inline void stable_sort(Compare comp = Compare(), unsigned threads = 1) {
+    if constexpr (std::is_trivially_copyable<T>::value) {
+      if (vec_sz < 2) {
+        return;
+      }
+      T *s = sort_scratch();
+      if (threads > 1 && vec_sz >= detail::parallel_sort_min) {
+        size_type chunk = (vec_sz + threads - 1) / threads;
+        detail::parallel_for(threads, threads, [&](size_t t) {
+          size_type lo = std::min(t * chunk, vec_sz), hi = std::min(lo + chunk, vec_sz);
+          detail::merge_sort(arr + lo, s + lo, hi - lo, comp);
+        });
+        detail::merge_runs(arr, s, vec_sz, chunk, threads, comp);
+      } else {
+        detail::merge_sort(arr, s, vec_sz, comp);
+      }
+    } else {
+      std::stable_sort(arr, arr + vec_sz, comp);
+    }
+  }
+
+  // stable ascending LSD radix sort for integral and floating-point T
+  inline void radix_sort(unsigned threads = 1) {
+    static_assert(std::is_arithmetic<T>::value, "radix_sort requires integral or floating T");
+    if (vec_sz < 2) {
+      return;
+    }
+    T *s = sort_scratch();
+    detail::radix_sort(arr, s, vec_sz, threads);
+  }
+
+#ifdef CATZ_VECTOR_FD_IO
+  // Reads up to max_bytes from fd straight into the spare capacity, looping on short reads
+  // until max_bytes (rounded down to whole elements) or EOF. Returns the number of bytes read.
+  // On a non-blocking fd, EAGAIN ends the read like EOF does and whatever arrived is kept.
+  // A partial trailing element (at EOF, or at EAGAIN if the writer stopped mid-element) is not
+  // counted in size(); its bytes are left at end() until the next modification. Other errors
+  // throw std::system_error, but only once everything read before them has been appended.
+  inline size_type append_from_fd(int fd, size_type max_bytes) {
+    return append_from_fd_impl(fd, max_bytes, nullptr);
+  }
+
+  // Same as above, but uses pread at offset and leaves the file position untouched.
+  inline size_type append_from_fd(int fd, size_type max_bytes, off_t offset) {
+    return append_from_fd_impl(fd, max_bytes, &offset);
+  }
+
+  // Appends everything up to EOF (or EAGAIN on a non-blocking fd). Regular files are sized with
+  // fstat so that at most one reallocation happens; other descriptors grow by the usual factor
+  // of 4. Errors are reported as in append_from_fd.
+  inline size_type read_into(int fd) {
+    static_assert(std::is_trivially_copyable<T>::value, "read_into requires trivially copyable T");
+    struct stat st;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) {
+      off_t cur = lseek(fd, 0, SEEK_CUR);
+      if (cur >= 0 && st.st_size > cur) {
+        reserve(vec_sz + static_cast<size_type>(st.st_size - cur) / sizeof(T) + 1);
+      }
+    }
+    size_type total = 0;
+    for (;;) {
+      if (vec_sz == rsrv_sz) {
+        grow();
+      }
+      size_type want = (rsrv_sz - vec_sz) * sizeof(T);
+      size_type got = read_fd(fd, reinterpret_cast<char *>(arr + vec_sz), want, nullptr);
+      vec_sz += got / sizeof(T);
+      total += got;
+      if (got < want) {
+        return total;
+      }
+    }
+  }
+#endif
+
   friend void Print(const vector<T> &v, const std::string &vec_name);
 
  private:
   inline void ensure_capacity(vector<T>::size_type required_sz) {
     if (required_sz > rsrv_sz) {
-      rsrv_sz = required_sz << 2;
-      reallocate();
+      reallocate(required_sz << 2);
+    }
+  }
+  inline void grow() { reallocate(rsrv_sz ? rsrv_sz << 2 : 4); }
+  inline T *sort_scratch() {
+    if (rsrv_sz - vec_sz < vec_sz) {
+      reallocate(vec_sz << 1);
+    }
+    return arr + vec_sz;
+  }
+#ifdef CATZ_VECTOR_FD_IO
+  // max_bytes is only a limit: the buffer is sized from fstat for regular files and otherwise
+  // grows by the usual factor of 4 while data keeps coming
+  inline size_type append_from_fd_impl(int fd, size_type max_bytes, off_t *offset) {
+    static_assert(
+        std::is_trivially_copyable<T>::value, "append_from_fd requires trivially copyable T");
+    size_type want = std::min(max_bytes, (max_size() - vec_sz) * sizeof(T));
+    want -= want % sizeof(T);
+    struct stat st;
+    if (want && fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) {
+      off_t cur = offset ? *offset : lseek(fd, 0, SEEK_CUR);
+      if (cur >= 0 && st.st_size > cur) {
+        size_type left = std::min(want, static_cast<size_type>(st.st_size - cur));
+        reserve(vec_sz + left / sizeof(T) + 1);
+      }
     }
+    size_type total = 0;
+    while (total < want) {
+      if (vec_sz == rsrv_sz) {
+        reallocate(rsrv_sz > max_size() / 4 ? max_size() : (rsrv_sz ? rsrv_sz << 2 : 4));
+      }
+      size_type chunk = std::min(want - total, (rsrv_sz - vec_sz) * sizeof(T));
+      off_t at = offset ? *offset + static_cast<off_t>(total) : 0;
+      size_type got = read_fd(
+          fd, reinterpret_cast<char *>(arr + vec_sz), chunk, offset ? &at : nullptr);
+      vec_sz += got / sizeof(T);
+      total += got;
+      if (got < chunk) {
+        break;
+      }
+    }
+    return total;
+  }
+  // loops on short reads and EINTR; stops at want bytes, EOF or EAGAIN. An error after some
+  // bytes were read returns those instead, so the caller appends them before the next call
+  // hits the error again with nothing read.
+  static inline size_type read_fd(int fd, char *dst, size_type want, off_t *offset) {
+    size_type done = 0;
+    while (done < want) {
+      size_t chunk = std::min<size_type>(want - done, size_type(1) << 30);
+      ssize_t n = offset ? pread(fd, dst + done, chunk, *offset + static_cast<off_t>(done))
+                         : read(fd, dst + done, chunk);
+      if (n < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        if (errno == EAGAIN || errno == EWOULDBLOCK || done) {
+          break;
+        }
+        throw std::system_error(errno, std::generic_category(), "read from fd failed");
+      }
+      if (n == 0) {
+        break;
+      }
+      done += static_cast<size_type>(n);
+    }
+    return done;
   }
+#endif
   template <typename Compare>
   inline bool compare(const vector<T> &rhs, Compare comp) const {
     size_type ub = vec_sz < rhs.vec_sz ? vec_sz : rhs.vec_sz;
@@ -352,64 +763,66 @@ class vector {
     }
     return comp(static_cast<T>(vec_sz), static_cast<T>(rhs.vec_sz));
   }
-  inline void reallocate() {
-    T *tarr = new (std::nothrow) T[rsrv_sz];
-    memcpy(tarr, arr, vec_sz * sizeof(T));
-    delete[] arr;
+  inline void reallocate(size_type n) {
+    T *tarr = detail::allocate_buffer<T>(n);
+    detail::relocate(tarr, arr, vec_sz);
+    detail::deallocate_buffer(arr, rsrv_sz);
     arr = tarr;
+    rsrv_sz = n;
   }
   void allocate_and_copy(size_type count, const T *first) {
     rsrv_sz = count << 2;
-    arr = static_cast<T *>(operator new[](rsrv_sz * sizeof(T)));
+    arr = detail::allocate_buffer<T>(rsrv_sz);
     std::uninitialized_copy(first, first + count, arr);
     vec_sz = count;
   }
   inline void resize_impl(typename vector<T>::size_type sz, const T *c = nullptr) {
     if (sz > vec_sz) {
       if (sz > rsrv_sz) {
-        rsrv_sz = sz;
-        reallocate();
+        reallocate(sz);
       }
       size_type i;
       for (i = vec_sz; i < sz; ++i) {
         if (c) {
-          arr[i] = *c;
+          new (&arr[i]) T(*c);
         } else {
           new (&arr[i]) T();
         }
       }
     } else {
       size_type i;
-      for (i = vec_sz; i < sz; ++i) arr[i].~T();
+      for (i = sz; i < vec_sz; ++i) arr[i].~T();
     }
     vec_sz = sz;
   }
   inline void erase_impl(
       typename vector<T>::const_iterator first, typename vector<T>::const_iterator last) {
     iterator f = &arr[first - arr];
+    size_type cnt = static_cast<size_type>(last - first);
     if constexpr (!std::is_trivially_destructible<T>::value) {
-      for (; first != last; ++first) {
-        (*first).~T();
+      for (iterator cur = f; cur != f + cnt; ++cur) {
+        cur->~T();
       }
     }
     memmove(f, last, (vec_sz - (last - arr)) * sizeof(T));
-    vec_sz -= last - first;
+    vec_sz -= cnt;
   }
   inline typename vector<T>::iterator insert_impl(
       typename vector<T>::const_iterator it, size_type cnt) {
-    iterator f = &arr[it - arr];
+    size_type idx = static_cast<size_type>(it - arr);
     if (vec_sz + cnt > rsrv_sz) {
-      rsrv_sz = (vec_sz + cnt) << 2;
-      reallocate();
+      reallocate((vec_sz + cnt) << 2);
     }
-    memmove(f + cnt, f, (vec_sz - (it - arr)) * sizeof(T));
+    iterator f = arr + idx;
+    memmove(f + cnt, f, (vec_sz - idx) * sizeof(T));
     vec_sz += cnt;
     return f;
   }
 
-  vector<T>::size_type rsrv_sz = 4, vec_sz = 0;
-  T *arr;
+  vector<T>::size_type rsrv_sz = 0, vec_sz = 0;
+  T *arr = nullptr;
 };
+
 template <typename T>
 inline void Print(const vector<T> &v, const std::string &vec_name) {
   typename vector<T>::size_type i = 0;